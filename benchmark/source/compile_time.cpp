@@ -0,0 +1,81 @@
+#include <disasm/decode.hpp>
+#include <disasm/decoder.hpp>
+#include <disasm/disassembler.hpp>
+#include <disasm/pattern_order.hpp>
+#include <decomp/decompiler.hpp>
+
+#include <span>
+#include <string>
+#include <vector>
+
+/*
+ * Synthetic architecture used to measure how compile time and compiler memory scale with the size of an instruction set.
+ * This file is only compiled, never run. Every instruction gets its own 12 bit opcode followed by a 4 bit operand.
+ */
+
+#if !defined(DC_SYNTHETIC_INSTRUCTION_COUNT)
+    #define DC_SYNTHETIC_INSTRUCTION_COUNT 2000
+#endif
+
+namespace dc::disasm::synthetic {
+
+    using namespace dc::ast;
+
+    constexpr size_t InstructionCount = DC_SYNTHETIC_INSTRUCTION_COUNT;
+    static_assert(InstructionCount > 0 && InstructionCount <= 4096, "Synthetic opcodes are 12 bits wide");
+
+    template<size_t Opcode>
+    consteval auto getPattern() {
+        char pattern[] = "oooo'oooo'oooo'aaaa";
+
+        size_t bit = 11;
+        for (char &c : pattern) {
+            if (c == 'o')
+                c = ((Opcode >> bit--) & 1) ? '1' : '0';
+        }
+
+        return hlp::StaticString(pattern);
+    }
+
+    template<size_t Opcode>
+    struct InstrSynthetic : public Instruction<"op", getPattern<Opcode>(), Category::Other, std::endian::big> {
+        using Parent = Instruction<"op", getPattern<Opcode>(), Category::Other, std::endian::big>;
+        using a = typename Parent::template Placeholder<'a'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, "{}, #{}", Opcode, a::get(bytes));
+        }
+
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
+            return { };
+        }
+    };
+
+    template<size_t ... Opcodes>
+    auto getInstructions(std::index_sequence<Opcodes...>) -> InstructionArray<InstrSynthetic<Opcodes>...>;
+
+    struct Architecture {
+        constexpr static auto InstructionSizeMin = 2;
+
+        using Instructions = OrderBySpecificity<decltype(getInstructions(std::make_index_sequence<InstructionCount>()))>;
+    };
+
+}
+
+using SyntheticArchitecture = dc::disasm::synthetic::Architecture;
+
+size_t decodeLinear(std::span<const dc::u8> bytes) {
+    return dc::disasm::decode<SyntheticArchitecture, dc::disasm::LinearDecoder>(bytes).size();
+}
+
+size_t decodeOpcodeTable(std::span<const dc::u8> bytes) {
+    return dc::disasm::decode<SyntheticArchitecture>(bytes).size();
+}
+
+std::vector<std::string> disassemble(std::span<const dc::u8> bytes) {
+    return dc::disasm::disassemble<SyntheticArchitecture>(bytes);
+}
+
+size_t decompile(std::span<const dc::u8> bytes) {
+    return dc::decomp::decompile<SyntheticArchitecture>(bytes).size();
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstdio>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+/*
+ * Compiler launcher that runs the compiler command passed to it and reports the wall time and
+ * the peak resident memory the compiler needed. Used to measure compile time scaling of large instruction sets.
+ */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fmt::print(stderr, "Usage: {} <compiler> [arguments...]\n", argv[0]);
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return 1;
+    }
+
+    if (pid == 0) {
+        execvp(argv[1], argv + 1);
+        std::perror("execvp");
+        _exit(127);
+    }
+
+    int status = 0;
+    rusage usage = { };
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        std::perror("wait4");
+        return 1;
+    }
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    /* ru_maxrss is reported in bytes on macOS and in kilobytes everywhere else */
+    #if defined(__APPLE__)
+        const double peakMemory = double(usage.ru_maxrss) / (1024 * 1024);
+    #else
+        const double peakMemory = double(usage.ru_maxrss) / 1024;
+    #endif
+
+    fmt::print("Compile time: {:.2f} s, peak compiler memory: {:.1f} MB\n", seconds, peakMemory);
+
+    if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+    else
+        return 1;
+}
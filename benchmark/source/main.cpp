@@ -0,0 +1,194 @@
+#include <disasm/decode.hpp>
+#include <disasm/decoder.hpp>
+#include <disasm/opcode_table.hpp>
+#include <disasm/decision_tree.hpp>
+#include <disasm/full_table.hpp>
+#include <disasm/ARM/classify.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+#include <decomp/ll_decompiler.hpp>
+#include <ast/flat_tree.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+using ThumbArchitecture = dc::disasm::arm::v7::thumb::Architecture;
+using i8051Architecture = dc::disasm::i8051::Architecture;
+
+namespace {
+
+    std::vector<dc::u8> loadImage(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    std::vector<dc::u8> generateImage(size_t size) {
+        std::mt19937 random(0x4D3);
+
+        std::vector<dc::u8> result(size);
+        for (auto &byte : result)
+            byte = dc::u8(random());
+
+        return result;
+    }
+
+    template<template<typename> typename Decoder>
+    auto benchmark(const char *name, std::span<const dc::u8> image, size_t iterations) {
+        std::vector<dc::disasm::DecodedInstruction<ThumbArchitecture>> instructions;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++)
+            instructions = dc::disasm::decode<ThumbArchitecture, Decoder>(image);
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto seconds = std::chrono::duration<double>(end - start).count();
+        fmt::print("  {:<16} {:>10.2f} ms  {:>8.1f} MB/s\n", name, seconds * 1000 / iterations, (image.size() * iterations) / seconds / (1024 * 1024));
+
+        return instructions;
+    }
+
+    /* Time spent in the decoder alone, looking up the instruction at every halfword of the image */
+    template<template<typename> typename Decoder>
+    void benchmarkFind(const char *name, std::span<const dc::u8> image, size_t iterations) {
+        using Instructions = ThumbArchitecture::Instructions;
+
+        size_t checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            for (size_t offset = 0; offset + sizeof(dc::u16) <= image.size(); offset += sizeof(dc::u16))
+                checksum += Decoder<Instructions>::find(image.subspan(offset, sizeof(dc::u16)));
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto lookups = iterations * (image.size() / sizeof(dc::u16));
+        fmt::print("  {:<16} {:>10.2f} ns/lookup  (checksum {})\n", name, std::chrono::duration<double, std::nano>(end - start).count() / std::max<size_t>(lookups, 1), checksum);
+    }
+
+    /* Classifying halfwords into their encoding groups, and grouped lookups of every halfword using the batched classification */
+    void benchmarkGroups(std::span<const dc::u8> image, size_t iterations) {
+        using Decoder = dc::disasm::arm::v7::thumb::GroupedDecoder<ThumbArchitecture::Instructions>;
+
+        std::vector<dc::disasm::arm::v7::thumb::Group> groups(image.size() / sizeof(dc::u16));
+        std::vector<dc::u16> indices(image.size() / sizeof(dc::u16));
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++)
+            dc::disasm::arm::v7::thumb::classify(image, groups);
+        auto end = std::chrono::steady_clock::now();
+
+        auto seconds = std::chrono::duration<double>(end - start).count();
+        fmt::print("  {:<16} {:>10.2f} ms  {:>8.1f} MB/s\n", "classify", seconds * 1000 / iterations, (image.size() * iterations) / seconds / (1024 * 1024));
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++)
+            Decoder::findAll(image, indices);
+        end = std::chrono::steady_clock::now();
+
+        const auto lookups = iterations * indices.size();
+        fmt::print("  {:<16} {:>10.2f} ns/lookup\n", "grouped batch", std::chrono::duration<double, std::nano>(end - start).count() / std::max<size_t>(lookups, 1));
+    }
+
+    /* Printing the lifted 8051 ASTs of an image straight from the pointer based nodes and from their flat form */
+    void benchmarkPrinting(std::span<const dc::u8> image, size_t iterations) {
+        const auto ast = dc::decomp::decompile<i8051Architecture>(image);
+
+        dc::decomp::MemorySink output;
+        dc::decomp::LowLevelDecompiler decompiler(output, i8051Architecture::Registers, i8051Architecture::Flags);
+
+        const auto measure = [&](const char *name, auto &&function) {
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; i++) {
+                output.clear();
+                function();
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            fmt::print("  {:<16} {:>10.2f} ns/statement\n", name, std::chrono::duration<double, std::nano>(end - start).count() / std::max<size_t>(iterations * ast.size(), 1));
+        };
+
+        measure("pointer tree", [&] {
+            for (const auto &node : ast)
+                decompiler.print(*node);
+        });
+
+        dc::ast::FlatTree tree;
+        measure("flatten", [&] {
+            tree = dc::ast::FlatTree::flatten(ast);
+        });
+
+        measure("flat tree", [&] {
+            for (auto node : tree.getStatements())
+                decompiler.print(tree, node);
+        });
+    }
+
+    bool isSame(const auto &a, const auto &b) {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].offset != b[i].offset || a[i].length != b[i].length || a[i].id != b[i].id)
+                return false;
+        }
+
+        return true;
+    }
+
+}
+
+/*
+ * Compares the Thumb decoders against each other and the ways of printing lifted ASTs. Pass firmware images as arguments, a random image is used otherwise.
+ */
+int main(int argc, char **argv) {
+    std::vector<std::pair<std::string, std::vector<dc::u8>>> images;
+    for (int i = 1; i < argc; i++)
+        images.emplace_back(argv[i], loadImage(argv[i]));
+
+    if (images.empty())
+        images.emplace_back("random", generateImage(4 * 1024 * 1024));
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+        (void)dc::disasm::FullTableDecoder<ThumbArchitecture::Instructions>::find(std::array<dc::u8, 2>{ });
+        const auto end = std::chrono::steady_clock::now();
+
+        fmt::print("Full table generation: {:.2f} ms\n", std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    for (const auto &[name, image] : images) {
+        const size_t iterations = std::max<size_t>(1, (64 * 1024 * 1024) / std::max<size_t>(image.size(), 1));
+
+        fmt::print("{} ({} bytes, {} iterations)\n", name, image.size(), iterations);
+
+        const auto linear   = benchmark<dc::disasm::LinearDecoder>("linear", image, iterations);
+        const auto opcodes  = benchmark<dc::disasm::OpcodeTable>("opcode table", image, iterations);
+        const auto tree     = benchmark<dc::disasm::DecisionTreeDecoder>("decision tree", image, iterations);
+        const auto full     = benchmark<dc::disasm::FullTableDecoder>("full table", image, iterations);
+        const auto grouped  = benchmark<dc::disasm::arm::v7::thumb::GroupedDecoder>("grouped", image, iterations);
+
+        if (!isSame(linear, opcodes) || !isSame(linear, tree) || !isSame(linear, full) || !isSame(linear, grouped))
+            fmt::print("  Decoders disagree!\n");
+
+        fmt::print("  Lookups only:\n");
+        benchmarkFind<dc::disasm::LinearDecoder>("linear", image, iterations);
+        benchmarkFind<dc::disasm::OpcodeTable>("opcode table", image, iterations);
+        benchmarkFind<dc::disasm::DecisionTreeDecoder>("decision tree", image, iterations);
+        benchmarkFind<dc::disasm::FullTableDecoder>("full table", image, iterations);
+        benchmarkFind<dc::disasm::arm::v7::thumb::GroupedDecoder>("grouped", image, iterations);
+
+        fmt::print("  Encoding groups:\n");
+        benchmarkGroups(image, iterations);
+
+        fmt::print("  Printing 8051 ASTs:\n");
+        benchmarkPrinting(image, std::max<size_t>(1, iterations / 4));
+    }
+}
@@ -0,0 +1,63 @@
+#include <disasm/profile.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace {
+
+    std::vector<dc::u8> loadImage(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    template<dc::disasm::ArchitectureType T>
+    int profile(std::string_view instructionsType, std::string_view architectureHeader, std::string_view orderNamespace, const char *outputPath, std::span<char *> imagePaths) {
+        dc::disasm::InstructionHistogram<T> histogram;
+        for (const char *path : imagePaths)
+            histogram.record(loadImage(path));
+
+        const auto &specificityOrder = dc::disasm::PatternOrder<typename T::Instructions>::getOrder();
+        const auto profiledOrder = histogram.getMatchOrder();
+
+        fmt::print("{} instructions recorded\n", histogram.getTotalCount());
+        fmt::print("  patterns tested per instruction, specificity order: {:.2f}\n", histogram.getAverageMatchCount(specificityOrder));
+        fmt::print("  patterns tested per instruction, profiled order:    {:.2f}\n", histogram.getAverageMatchCount(profiledOrder));
+
+        std::ofstream output(outputPath);
+        output << dc::disasm::generateOrderHeader(histogram, instructionsType, architectureHeader, orderNamespace);
+
+        return output.good() ? 0 : 1;
+    }
+
+}
+
+/*
+ * Records an instruction histogram over a set of firmware images and writes a header with the match order for ProfiledDecoder.
+ * The order and its decoder are declared in namespace dc::disasm::profiled::i8051 or dc::disasm::profiled::thumb.
+ *
+ * Usage: DecompilerProfiler <8051|thumb> <output header> <images...>
+ */
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fmt::print(stderr, "Usage: {} <8051|thumb> <output header> <images...>\n", argv[0]);
+        return 1;
+    }
+
+    const std::string_view architecture = argv[1];
+    const auto images = std::span(argv + 3, argv + argc);
+
+    if (architecture == "8051")
+        return profile<dc::disasm::i8051::Architecture>("dc::disasm::i8051::Architecture::Instructions", "disasm/i8051/instructions.hpp", "i8051", argv[2], images);
+    else if (architecture == "thumb")
+        return profile<dc::disasm::arm::v7::thumb::Architecture>("dc::disasm::arm::v7::thumb::Architecture::Instructions", "disasm/ARM/instructions.hpp", "thumb", argv[2], images);
+
+    fmt::print(stderr, "Unknown architecture {}\n", architecture);
+    return 1;
+}
@@ -0,0 +1,50 @@
+#include <i8051_match_order.hpp>
+#include <thumb_match_order.hpp>
+
+#include <disasm/decode.hpp>
+#include <disasm/opcode_table.hpp>
+
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace {
+
+    std::vector<dc::u8> generateImage(size_t size) {
+        std::mt19937 random(0x4D3);
+
+        std::vector<dc::u8> result(size);
+        for (auto &byte : result)
+            byte = dc::u8(random());
+
+        return result;
+    }
+
+    template<dc::disasm::ArchitectureType T, template<typename> typename Decoder>
+    bool check(const char *name, std::span<const dc::u8> image) {
+        const auto expected = dc::disasm::decode<T, dc::disasm::OpcodeTable>(image);
+        const auto actual   = dc::disasm::decode<T, Decoder>(image);
+
+        bool same = expected.size() == actual.size();
+        for (size_t i = 0; same && i < expected.size(); i++)
+            same = expected[i].offset == actual[i].offset && expected[i].length == actual[i].length && expected[i].id == actual[i].id;
+
+        fmt::print("{}: profiled decoder {} the opcode table\n", name, same ? "matches" : "disagrees with");
+
+        return same;
+    }
+
+}
+
+/*
+ * Builds the decoders of the match order headers generated by DecompilerProfiler and checks them against the opcode table
+ */
+int main() {
+    const auto image = generateImage(256 * 1024);
+
+    const bool i8051 = check<dc::disasm::i8051::Architecture, dc::disasm::profiled::i8051::Decoder>("8051", image);
+    const bool thumb = check<dc::disasm::arm::v7::thumb::Architecture, dc::disasm::profiled::thumb::Decoder>("thumb", image);
+
+    return i8051 && thumb ? 0 : 1;
+}
@@ -1,27 +1,92 @@
 #pragma once
 
 #include <dc.hpp>
+#include <ast/node_arena.hpp>
 
 #include <memory>
+#include <ranges>
 #include <vector>
 #include <string>
+#include <string_view>
 
 namespace dc::decomp { class Visitor; }
 
 namespace dc::ast {
 
+    /* Index of a register or flag in its architecture's register or flag table */
+    using RegisterId = u16;
+
+    enum class NodeKind : u8 {
+        IntegerLiteral,
+        Register,
+        Flag,
+        Jump,
+        Assignment,
+        UnaryArithmetic,
+        BinaryArithmetic,
+        Conditional,
+        ControlFlowStatement,
+        Assembly,
+        FunctionCall
+    };
+
+    class ASTNode;
+
+    /* Deletes heap nodes and leaves arena nodes alone, their memory goes away together with the arena */
+    struct NodeDeleter {
+        void operator()(ASTNode *node) const;
+    };
+
+    /*
+     * Owning pointer to a node and the node lists and strings owned by nodes.
+     * While a NodeArena is active, all of them get their memory from it. Arena nodes may only own nodes, lists
+     * and strings created while the same arena was active, since their destructors never run.
+     */
+    using NodePtr       = std::unique_ptr<ASTNode, NodeDeleter>;
+    using NodeList      = std::vector<NodePtr, NodeAllocator<NodePtr>>;
+    using NodeString    = std::basic_string<char, std::char_traits<char>, NodeAllocator<char>>;
+
     class ASTNode {
     public:
+        explicit ASTNode(NodeKind kind) : m_kind(kind) { }
+        virtual ~ASTNode() = default;
+
         virtual void accept(dc::decomp::Visitor &visitor) = 0;
+
+        [[nodiscard]] constexpr NodeKind getKind() const { return this->m_kind; }
+        [[nodiscard]] constexpr bool isArenaAllocated() const { return this->m_arenaAllocated; }
+
+    private:
+        template<typename T, typename ... Params>
+        friend NodePtr create(Params && ... params);
+
+        NodeKind m_kind;
+        bool m_arenaAllocated = false;
     };
 
-    template<typename T>
-    std::unique_ptr<ASTNode> create(auto && ... params) {
-        return std::unique_ptr<ASTNode>(new T(std::forward<decltype(params)>(params)...));
+    inline void NodeDeleter::operator()(ASTNode *node) const {
+        if (!node->isArenaAllocated())
+            delete node;
     }
 
-    std::vector<std::unique_ptr<ASTNode>> asVector(auto && ... nodes) {
-        std::vector<std::unique_ptr<ASTNode>> result;
+    /* Creates a node in the thread's active NodeArena if there is one and on the heap otherwise */
+    template<typename T, typename ... Params>
+    NodePtr create(Params && ... params) {
+        if (auto arena = NodeArenaScope::getCurrentArena(); arena != nullptr) {
+            static_assert(alignof(T) <= NodeArena::Alignment);
+
+            auto node = new (arena->allocate(sizeof(T))) T(std::forward<Params>(params)...);
+            node->m_arenaAllocated = true;
+
+            return NodePtr(node);
+        }
+
+        return NodePtr(new T(std::forward<Params>(params)...));
+    }
+
+    NodeList asVector(auto && ... nodes) {
+        NodeList result;
+        result.reserve(sizeof...(nodes));
 
         (result.push_back(std::move(nodes)), ...);
 
@@ -30,7 +95,7 @@ namespace dc::ast {
 
     class ASTNodeIntegerLiteral : public ASTNode {
     public:
-        ASTNodeIntegerLiteral(u32 value) : m_value(value) {}
+        ASTNodeIntegerLiteral(u32 value) : ASTNode(NodeKind::IntegerLiteral), m_value(value) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
         [[nodiscard]] constexpr u32 getValue() const { return this->m_value; }
@@ -41,47 +106,47 @@ namespace dc::ast {
 
     class ASTNodeRegister : public ASTNode {
     public:
-        ASTNodeRegister(std::string registerName) : m_registerName(std::move(registerName)) {}
+        ASTNodeRegister(RegisterId registerId) : ASTNode(NodeKind::Register), m_registerId(registerId) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::string& getRegisterName() const { return this->m_registerName; }
+        [[nodiscard]] constexpr RegisterId getRegisterId() const { return this->m_registerId; }
 
     private:
-        std::string m_registerName;
+        RegisterId m_registerId;
     };
 
     class ASTNodeFlag : public ASTNode {
     public:
-        ASTNodeFlag(std::string flagName) : m_flagName(std::move(flagName)) {}
+        ASTNodeFlag(RegisterId flagId) : ASTNode(NodeKind::Flag), m_flagId(flagId) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::string& getFlagName() const { return this->m_flagName; }
+        [[nodiscard]] constexpr RegisterId getFlagId() const { return this->m_flagId; }
 
     private:
-        std::string m_flagName;
+        RegisterId m_flagId;
     };
 
     class ASTNodeJump : public ASTNode {
     public:
-        ASTNodeJump(std::unique_ptr<ASTNode> &&destination) : m_destination(std::move(destination)) {}
+        ASTNodeJump(NodePtr &&destination) : ASTNode(NodeKind::Jump), m_destination(std::move(destination)) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getDestination() const { return this->m_destination; }
+        [[nodiscard]] constexpr const NodePtr& getDestination() const { return this->m_destination; }
 
     private:
-        std::unique_ptr<ASTNode> m_destination;
+        NodePtr m_destination;
     };
 
     class ASTNodeAssignment : public ASTNode {
     public:
-        ASTNodeAssignment(std::unique_ptr<ASTNode> &&source, std::unique_ptr<ASTNode> &&destination) : m_source(std::move(source)), m_destination(std::move(destination)) {}
+        ASTNodeAssignment(NodePtr &&source, NodePtr &&destination) : ASTNode(NodeKind::Assignment), m_source(std::move(source)), m_destination(std::move(destination)) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getSource() const { return this->m_source; }
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getDestination() const { return this->m_destination; }
+        [[nodiscard]] constexpr const NodePtr& getSource() const { return this->m_source; }
+        [[nodiscard]] constexpr const NodePtr& getDestination() const { return this->m_destination; }
 
     private:
-        std::unique_ptr<ASTNode> m_source, m_destination;
+        NodePtr m_source, m_destination;
     };
 
     class ASTNodeUnaryArithmetic : public ASTNode {
@@ -94,15 +159,15 @@ namespace dc::ast {
             Dereference
         };
     public:
-        ASTNodeUnaryArithmetic(std::unique_ptr<ASTNode> &&operand, Operator op)
-                : m_operand(std::move(operand)), m_operator(op) {}
+        ASTNodeUnaryArithmetic(NodePtr &&operand, Operator op)
+                : ASTNode(NodeKind::UnaryArithmetic), m_operand(std::move(operand)), m_operator(op) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getOperand() const { return this->m_operand; }
+        [[nodiscard]] constexpr const NodePtr& getOperand() const { return this->m_operand; }
         [[nodiscard]] constexpr Operator getOperator() const { return this->m_operator; }
 
     private:
-        std::unique_ptr<ASTNode> m_operand;
+        NodePtr m_operand;
         Operator m_operator;
     };
 
@@ -133,32 +198,32 @@ namespace dc::ast {
             BitXor
         };
     public:
-        ASTNodeBinaryArithmetic(std::unique_ptr<ASTNode> &&lhs, std::unique_ptr<ASTNode> &&rhs, Operator op)
-            : m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_operator(op) {}
+        ASTNodeBinaryArithmetic(NodePtr &&lhs, NodePtr &&rhs, Operator op)
+            : ASTNode(NodeKind::BinaryArithmetic), m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_operator(op) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getLeftHandSide() const { return this->m_lhs; }
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getRightHandSide() const { return this->m_rhs; }
+        [[nodiscard]] constexpr const NodePtr& getLeftHandSide() const { return this->m_lhs; }
+        [[nodiscard]] constexpr const NodePtr& getRightHandSide() const { return this->m_rhs; }
         [[nodiscard]] constexpr Operator getOperator() const { return this->m_operator; }
 
     private:
-        std::unique_ptr<ASTNode> m_lhs, m_rhs;
+        NodePtr m_lhs, m_rhs;
         Operator m_operator;
     };
 
     class ASTNodeConditional : public ASTNode {
     public:
-        ASTNodeConditional(std::unique_ptr<ASTNode> &&condition, std::vector<std::unique_ptr<ASTNode>> &&trueBlock, std::vector<std::unique_ptr<ASTNode>> &&falseBlock)
-                : m_condition(std::move(condition)), m_trueBlock(std::move(trueBlock)), m_falseBlock(std::move(falseBlock)) {}
+        ASTNodeConditional(NodePtr &&condition, NodeList &&trueBlock, NodeList &&falseBlock)
+                : ASTNode(NodeKind::Conditional), m_condition(std::move(condition)), m_trueBlock(std::move(trueBlock)), m_falseBlock(std::move(falseBlock)) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getCondition() const { return this->m_condition; }
-        [[nodiscard]] constexpr const std::vector<std::unique_ptr<ASTNode>>& getTrueBlock() const { return this->m_trueBlock; }
-        [[nodiscard]] constexpr const std::vector<std::unique_ptr<ASTNode>>& getFalseBlock() const { return this->m_falseBlock; }
+        [[nodiscard]] constexpr const NodePtr& getCondition() const { return this->m_condition; }
+        [[nodiscard]] constexpr const NodeList& getTrueBlock() const { return this->m_trueBlock; }
+        [[nodiscard]] constexpr const NodeList& getFalseBlock() const { return this->m_falseBlock; }
 
     private:
-        std::unique_ptr<ASTNode> m_condition;
-        std::vector<std::unique_ptr<ASTNode>> m_trueBlock, m_falseBlock;
+        NodePtr m_condition;
+        NodeList m_trueBlock, m_falseBlock;
     };
 
     class ASTNodeControlFlowStatement : public ASTNode {
@@ -169,7 +234,7 @@ namespace dc::ast {
             Return
         };
 
-        ASTNodeControlFlowStatement(Type type) : m_type(type) {}
+        ASTNodeControlFlowStatement(Type type) : ASTNode(NodeKind::ControlFlowStatement), m_type(type) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
         [[nodiscard]] constexpr const Type getType() const { return this->m_type; }
@@ -180,24 +245,98 @@ namespace dc::ast {
 
     class ASTNodeAssembly : public ASTNode {
     public:
-        ASTNodeAssembly(std::string assembly) : m_assembly(std::move(assembly)) {}
+        ASTNodeAssembly(std::string_view assembly) : ASTNode(NodeKind::Assembly), m_assembly(assembly) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::string& getAssembly() const { return this->m_assembly; }
+        [[nodiscard]] constexpr const NodeString& getAssembly() const { return this->m_assembly; }
 
     private:
-        std::string m_assembly;
+        NodeString m_assembly;
     };
 
     class ASTNodeFunctionCall : public ASTNode {
     public:
-        ASTNodeFunctionCall(std::unique_ptr<ASTNode>&& destination) : m_destination(std::move(destination)) {}
+        ASTNodeFunctionCall(NodePtr&& destination) : ASTNode(NodeKind::FunctionCall), m_destination(std::move(destination)) {}
 
         void accept(dc::decomp::Visitor &visitor) override;
-        [[nodiscard]] constexpr const std::unique_ptr<ASTNode>& getDestination() const { return this->m_destination; }
+        [[nodiscard]] constexpr const NodePtr& getDestination() const { return this->m_destination; }
+
+    private:
+        NodePtr m_destination;
+    };
+
+    /*
+     * Calls the visitor with the node cast to its concrete type, chosen by a switch over the node's kind.
+     * Unlike accept() this needs no virtual calls, so passes dispatching through here can be fully inlined.
+     * The visitor has to be callable with every node type, e.g. a generic lambda or a set of overloads.
+     */
+    template<typename Visitor>
+    decltype(auto) dispatch(ASTNode &node, Visitor &&visitor) {
+        switch (node.getKind()) {
+            using enum NodeKind;
+            case IntegerLiteral:        return visitor(static_cast<ASTNodeIntegerLiteral&>(node));
+            case Register:              return visitor(static_cast<ASTNodeRegister&>(node));
+            case Flag:                  return visitor(static_cast<ASTNodeFlag&>(node));
+            case Jump:                  return visitor(static_cast<ASTNodeJump&>(node));
+            case Assignment:            return visitor(static_cast<ASTNodeAssignment&>(node));
+            case UnaryArithmetic:       return visitor(static_cast<ASTNodeUnaryArithmetic&>(node));
+            case BinaryArithmetic:      return visitor(static_cast<ASTNodeBinaryArithmetic&>(node));
+            case Conditional:           return visitor(static_cast<ASTNodeConditional&>(node));
+            case ControlFlowStatement:  return visitor(static_cast<ASTNodeControlFlowStatement&>(node));
+            case Assembly:              return visitor(static_cast<ASTNodeAssembly&>(node));
+            case FunctionCall:          return visitor(static_cast<ASTNodeFunctionCall&>(node));
+        }
+
+        __builtin_unreachable();
+    }
+
+    /*
+     * Read access to pointer based ASTs through the same getters FlatTree offers, so code like printers can be written once for both
+     */
+    class PointerTree {
+    public:
+        using Node = const ASTNode*;
+
+    private:
+        static auto asNodes(const NodeList &block) {
+            return block | std::views::transform([](const NodePtr &node) -> Node { return node.get(); });
+        }
+
+    public:
+        [[nodiscard]] static NodeKind getKind(Node node) { return node->getKind(); }
+
+        [[nodiscard]] static u32 getValue(Node node) { return as<ASTNodeIntegerLiteral>(node).getValue(); }
+        [[nodiscard]] static RegisterId getRegisterId(Node node) { return as<ASTNodeRegister>(node).getRegisterId(); }
+        [[nodiscard]] static RegisterId getFlagId(Node node) { return as<ASTNodeFlag>(node).getFlagId(); }
+
+        [[nodiscard]] static Node getDestination(Node node) {
+            switch (node->getKind()) {
+                case NodeKind::Jump:            return as<ASTNodeJump>(node).getDestination().get();
+                case NodeKind::FunctionCall:    return as<ASTNodeFunctionCall>(node).getDestination().get();
+                default:                        return as<ASTNodeAssignment>(node).getDestination().get();
+            }
+        }
+
+        [[nodiscard]] static Node getSource(Node node) { return as<ASTNodeAssignment>(node).getSource().get(); }
+
+        [[nodiscard]] static Node getOperand(Node node) { return as<ASTNodeUnaryArithmetic>(node).getOperand().get(); }
+        [[nodiscard]] static ASTNodeUnaryArithmetic::Operator getUnaryOperator(Node node) { return as<ASTNodeUnaryArithmetic>(node).getOperator(); }
+
+        [[nodiscard]] static Node getLeftHandSide(Node node) { return as<ASTNodeBinaryArithmetic>(node).getLeftHandSide().get(); }
+        [[nodiscard]] static Node getRightHandSide(Node node) { return as<ASTNodeBinaryArithmetic>(node).getRightHandSide().get(); }
+        [[nodiscard]] static ASTNodeBinaryArithmetic::Operator getBinaryOperator(Node node) { return as<ASTNodeBinaryArithmetic>(node).getOperator(); }
+
+        [[nodiscard]] static Node getCondition(Node node) { return as<ASTNodeConditional>(node).getCondition().get(); }
+        [[nodiscard]] static auto getTrueBlock(Node node) { return asNodes(as<ASTNodeConditional>(node).getTrueBlock()); }
+        [[nodiscard]] static auto getFalseBlock(Node node) { return asNodes(as<ASTNodeConditional>(node).getFalseBlock()); }
+
+        [[nodiscard]] static ASTNodeControlFlowStatement::Type getControlFlowType(Node node) { return as<ASTNodeControlFlowStatement>(node).getType(); }
+
+        [[nodiscard]] static std::string_view getAssembly(Node node) { return as<ASTNodeAssembly>(node).getAssembly(); }
 
     private:
-        std::unique_ptr<ASTNode> m_destination;
+        template<typename T>
+        static const T& as(Node node) { return static_cast<const T&>(*node); }
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <dc.hpp>
+#include <ast/ast_node.hpp>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dc::ast {
+
+    /*
+     * Reference to a node of a FlatTree, packing the kind of the node and its index within the pool of that kind into 32 bits
+     */
+    class NodeRef {
+    public:
+        constexpr static u32 IndexBits = 28;
+        constexpr static u32 IndexMask = (u32(1) << IndexBits) - 1;
+
+        constexpr NodeRef() = default;
+        constexpr NodeRef(NodeKind kind, u32 index) : m_value((u32(kind) << IndexBits) | index) { }
+
+        [[nodiscard]] constexpr NodeKind getKind() const { return NodeKind(this->m_value >> IndexBits); }
+        [[nodiscard]] constexpr u32 getIndex() const { return this->m_value & IndexMask; }
+
+        constexpr bool operator==(const NodeRef &) const = default;
+
+    private:
+        u32 m_value = 0;
+    };
+
+    /*
+     * AST stored in one contiguous pool per node kind instead of individually allocated nodes linked through pointers.
+     * Every node only holds its own fields, e.g. a register node is just its register id and a binary arithmetic node
+     * its operator and two NodeRefs. Passes only interested in one kind of node scan that kind's pool linearly.
+     *
+     * The instruction lifters produce pointer based ASTs, flatten() converts those once they've been lifted.
+     * Read access goes through the same getters PointerTree offers for pointer based ASTs, so code like the
+     * LowLevelDecompiler's printer works on both.
+     */
+    class FlatTree {
+    public:
+        using Node = NodeRef;
+
+        NodeRef addIntegerLiteral(u32 value) {
+            return add(NodeKind::IntegerLiteral, this->m_integerLiterals, value);
+        }
+
+        NodeRef addRegister(RegisterId registerId) {
+            return add(NodeKind::Register, this->m_registers, registerId);
+        }
+
+        NodeRef addFlag(RegisterId flagId) {
+            return add(NodeKind::Flag, this->m_flags, flagId);
+        }
+
+        NodeRef addJump(NodeRef destination) {
+            return add(NodeKind::Jump, this->m_jumps, destination);
+        }
+
+        NodeRef addAssignment(NodeRef source, NodeRef destination) {
+            return add(NodeKind::Assignment, this->m_assignments, { source, destination });
+        }
+
+        NodeRef addUnaryArithmetic(NodeRef operand, ASTNodeUnaryArithmetic::Operator op) {
+            return add(NodeKind::UnaryArithmetic, this->m_unaryArithmetics, { operand, op });
+        }
+
+        NodeRef addBinaryArithmetic(NodeRef lhs, NodeRef rhs, ASTNodeBinaryArithmetic::Operator op) {
+            return add(NodeKind::BinaryArithmetic, this->m_binaryArithmetics, { lhs, rhs, op });
+        }
+
+        NodeRef addConditional(NodeRef condition, std::span<const NodeRef> trueBlock, std::span<const NodeRef> falseBlock) {
+            return add(NodeKind::Conditional, this->m_conditionals, { condition, this->addBlock(trueBlock), this->addBlock(falseBlock) });
+        }
+
+        NodeRef addControlFlowStatement(ASTNodeControlFlowStatement::Type type) {
+            return add(NodeKind::ControlFlowStatement, this->m_controlFlowStatements, type);
+        }
+
+        NodeRef addAssembly(std::string_view assembly) {
+            return add(NodeKind::Assembly, this->m_assemblies, this->addString(assembly));
+        }
+
+        NodeRef addFunctionCall(NodeRef destination) {
+            return add(NodeKind::FunctionCall, this->m_functionCalls, destination);
+        }
+
+        /* Appends a node to the top level statements of the tree */
+        void addStatement(NodeRef node) {
+            this->m_statements.push_back(node);
+        }
+
+        [[nodiscard]] std::span<const NodeRef> getStatements() const { return this->m_statements; }
+
+        /* Pools of the leaf nodes, for passes scanning all of them */
+        [[nodiscard]] std::span<const u32> getIntegerLiterals() const { return this->m_integerLiterals; }
+        [[nodiscard]] std::span<const RegisterId> getRegisters() const { return this->m_registers; }
+        [[nodiscard]] std::span<const RegisterId> getFlags() const { return this->m_flags; }
+
+        [[nodiscard]] static NodeKind getKind(NodeRef node) { return node.getKind(); }
+
+        [[nodiscard]] u32 getValue(NodeRef node) const { return this->m_integerLiterals[node.getIndex()]; }
+        [[nodiscard]] RegisterId getRegisterId(NodeRef node) const { return this->m_registers[node.getIndex()]; }
+        [[nodiscard]] RegisterId getFlagId(NodeRef node) const { return this->m_flags[node.getIndex()]; }
+
+        [[nodiscard]] NodeRef getDestination(NodeRef node) const {
+            switch (node.getKind()) {
+                case NodeKind::Jump:            return this->m_jumps[node.getIndex()];
+                case NodeKind::FunctionCall:    return this->m_functionCalls[node.getIndex()];
+                default:                        return this->m_assignments[node.getIndex()].destination;
+            }
+        }
+
+        [[nodiscard]] NodeRef getSource(NodeRef node) const { return this->m_assignments[node.getIndex()].source; }
+
+        [[nodiscard]] NodeRef getOperand(NodeRef node) const { return this->m_unaryArithmetics[node.getIndex()].operand; }
+        [[nodiscard]] ASTNodeUnaryArithmetic::Operator getUnaryOperator(NodeRef node) const { return this->m_unaryArithmetics[node.getIndex()].op; }
+
+        [[nodiscard]] NodeRef getLeftHandSide(NodeRef node) const { return this->m_binaryArithmetics[node.getIndex()].lhs; }
+        [[nodiscard]] NodeRef getRightHandSide(NodeRef node) const { return this->m_binaryArithmetics[node.getIndex()].rhs; }
+        [[nodiscard]] ASTNodeBinaryArithmetic::Operator getBinaryOperator(NodeRef node) const { return this->m_binaryArithmetics[node.getIndex()].op; }
+
+        [[nodiscard]] NodeRef getCondition(NodeRef node) const { return this->m_conditionals[node.getIndex()].condition; }
+        [[nodiscard]] std::span<const NodeRef> getTrueBlock(NodeRef node) const { return this->getBlock(this->m_conditionals[node.getIndex()].trueBlock); }
+        [[nodiscard]] std::span<const NodeRef> getFalseBlock(NodeRef node) const { return this->getBlock(this->m_conditionals[node.getIndex()].falseBlock); }
+
+        [[nodiscard]] ASTNodeControlFlowStatement::Type getControlFlowType(NodeRef node) const { return this->m_controlFlowStatements[node.getIndex()]; }
+
+        [[nodiscard]] std::string_view getAssembly(NodeRef node) const {
+            const auto &range = this->m_assemblies[node.getIndex()];
+            return std::string_view(this->m_stringData).substr(range.begin, range.count);
+        }
+
+        void clear();
+
+        /* Converts a list of lifted pointer based ASTs into their flat form, every AST becoming a top level statement */
+        [[nodiscard]] static FlatTree flatten(std::span<const NodePtr> nodes);
+
+    private:
+        struct Range {
+            u32 begin, count;
+        };
+
+        struct Assignment {
+            NodeRef source, destination;
+        };
+
+        struct UnaryArithmetic {
+            NodeRef operand;
+            ASTNodeUnaryArithmetic::Operator op;
+        };
+
+        struct BinaryArithmetic {
+            NodeRef lhs, rhs;
+            ASTNodeBinaryArithmetic::Operator op;
+        };
+
+        struct Conditional {
+            NodeRef condition;
+            Range trueBlock, falseBlock;
+        };
+
+        template<typename T>
+        static NodeRef add(NodeKind kind, std::vector<T> &pool, T node) {
+            pool.push_back(node);
+            return { kind, u32(pool.size() - 1) };
+        }
+
+        Range addBlock(std::span<const NodeRef> nodes) {
+            const Range range = { u32(this->m_blockNodes.size()), u32(nodes.size()) };
+            this->m_blockNodes.insert(this->m_blockNodes.end(), nodes.begin(), nodes.end());
+
+            return range;
+        }
+
+        Range addString(std::string_view string) {
+            const Range range = { u32(this->m_stringData.size()), u32(string.size()) };
+            this->m_stringData.append(string);
+
+            return range;
+        }
+
+        [[nodiscard]] std::span<const NodeRef> getBlock(Range range) const {
+            return std::span(this->m_blockNodes).subspan(range.begin, range.count);
+        }
+
+        std::vector<u32> m_integerLiterals;
+        std::vector<RegisterId> m_registers, m_flags;
+        std::vector<NodeRef> m_jumps, m_functionCalls;
+        std::vector<Assignment> m_assignments;
+        std::vector<UnaryArithmetic> m_unaryArithmetics;
+        std::vector<BinaryArithmetic> m_binaryArithmetics;
+        std::vector<Conditional> m_conditionals;
+        std::vector<ASTNodeControlFlowStatement::Type> m_controlFlowStatements;
+        std::vector<Range> m_assemblies;
+
+        std::vector<NodeRef> m_statements, m_blockNodes;
+        std::string m_stringData;
+    };
+
+}
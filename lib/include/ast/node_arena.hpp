@@ -0,0 +1,102 @@
+#pragma once
+
+#include <dc.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dc::ast {
+
+    /*
+     * Bump allocator for AST nodes and the lists and strings they own. While a NodeArenaScope for it is active on a thread,
+     * all of these are carved out of large blocks owned by the arena instead of being allocated one by one on the heap.
+     * Nothing allocated from an arena is ever destroyed or freed on its own, the memory is given back all at once
+     * when the arena is reset or destroyed. The arena therefore needs to outlive every node allocated from it.
+     */
+    class NodeArena {
+    public:
+        constexpr static size_t DefaultBlockSize = 64 * 1024;
+        constexpr static size_t Alignment = alignof(std::max_align_t);
+
+        explicit NodeArena(size_t blockSize = DefaultBlockSize) : m_blockSize(blockSize) { }
+
+        NodeArena(const NodeArena &) = delete;
+        NodeArena &operator=(const NodeArena &) = delete;
+
+        [[nodiscard]] void *allocate(size_t size);
+
+        /* Drops all allocations at once while keeping the first block around for reuse */
+        void reset();
+
+        [[nodiscard]] size_t getBlockCount() const { return this->m_blocks.size(); }
+
+        /* Number of bytes handed out since the arena was created or last reset */
+        [[nodiscard]] size_t getAllocatedSize() const { return this->m_allocatedSize; }
+
+    private:
+        std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+        std::byte *m_current = nullptr, *m_end = nullptr;
+        size_t m_blockSize;
+        size_t m_allocatedSize = 0;
+    };
+
+    /*
+     * Makes an arena the target of all node allocations on the current thread for the lifetime of the scope.
+     * Scopes may be nested, the previously active arena is restored once the scope ends.
+     */
+    class NodeArenaScope {
+    public:
+        explicit NodeArenaScope(NodeArena &arena);
+        ~NodeArenaScope();
+
+        NodeArenaScope(const NodeArenaScope &) = delete;
+        NodeArenaScope &operator=(const NodeArenaScope &) = delete;
+
+        [[nodiscard]] static NodeArena *getCurrentArena();
+
+    private:
+        NodeArena *m_previousArena;
+    };
+
+    /*
+     * Standard allocator for the containers owned by AST nodes. It sticks to the arena that was active on the thread
+     * when it was created, or to the heap if there was none. Deallocating arena memory does nothing.
+     */
+    template<typename T>
+    class NodeAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        NodeAllocator() : m_arena(NodeArenaScope::getCurrentArena()) { }
+
+        template<typename U>
+        constexpr NodeAllocator(const NodeAllocator<U> &other) : m_arena(other.getArena()) { }
+
+        [[nodiscard]] T *allocate(size_t count) {
+            static_assert(alignof(T) <= NodeArena::Alignment);
+
+            if (this->m_arena != nullptr)
+                return static_cast<T*>(this->m_arena->allocate(count * sizeof(T)));
+            else
+                return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T *pointer, size_t count) {
+            if (this->m_arena == nullptr)
+                std::allocator<T>().deallocate(pointer, count);
+        }
+
+        [[nodiscard]] constexpr NodeArena *getArena() const { return this->m_arena; }
+
+        template<typename U>
+        constexpr bool operator==(const NodeAllocator<U> &other) const { return this->m_arena == other.getArena(); }
+
+    private:
+        NodeArena *m_arena;
+    };
+
+}
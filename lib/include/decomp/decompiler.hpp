@@ -3,6 +3,7 @@
 #include <disasm/architecture.hpp>
 #include <disasm/instruction.hpp>
 #include <disasm/disassembler.hpp>
+#include <disasm/decode.hpp>
 #include <span>
 
 #include <ast/ast_node.hpp>
@@ -26,18 +27,14 @@ namespace dc::decomp {
 
     namespace {
 
-        template<std::derived_from<dc::hlp::TypeArrayBase> T, size_t Index>
-        std::pair<size_t, std::vector<std::unique_ptr<ast::ASTNode>>> decompile(u64 offset, std::span<const u8> bytes) {
-            using Instr = typename T::template Get<Index>;
-            using namespace ast;
-
-            if (Instr::Pattern::matches(bytes)) {
-                return { Instr::Pattern::getByteCount(), Instr::decompile(offset, bytes) };
-            }
-            else if constexpr (Index < (T::Size - 1))
-                return decompile<T, Index + 1>(offset, bytes);
-            else
-                return {};
+        template<disasm::InstructionType Instr>
+        ast::NodeList decompile(u64 offset, std::span<const u8> bytes) {
+            return Instr::decompile(offset, bytes);
+        }
+
+        template<typename ... Instrs>
+        constexpr auto getDecompilers(const hlp::TypeArray<Instrs...> &) {
+            return std::array { &decompile<Instrs>... };
         }
 
     }
@@ -45,28 +42,28 @@ namespace dc::decomp {
 
 
     template<dc::disasm::ArchitectureType T>
-    auto decompile(std::span<const u8> bytes) {
-        std::vector<std::unique_ptr<ast::ASTNode>> ast;
-        size_t offset = 0x00;
-
-        while (offset < bytes.size()) {
-            auto begin = bytes.begin() + offset;
-
-            auto [size, nodes] = decompile<typename T::Instructions, 0>(offset, std::span { begin, bytes.end() });
-            if (size < T::InstructionSizeMin) {
+    ast::NodeList decompile(std::span<const u8> bytes, std::span<const disasm::DecodedInstruction<T>> instructions) {
+        using Instructions = typename T::Instructions;
+        constexpr static auto Decompilers = getDecompilers(Instructions{ });
 
-                offset += 1;
+        ast::NodeList ast;
 
-            }
-            else {
-                for (auto &&node : nodes)
-                    ast.emplace_back(std::move(node));
+        for (const auto &instruction : instructions) {
+            if (!instruction.isValid())
+                continue;
 
-                offset += size;
-            }
+            for (auto &&node : Decompilers[instruction.id](instruction.offset, bytes.subspan(instruction.offset)))
+                ast.emplace_back(std::move(node));
         }
 
         return ast;
     }
 
+    template<dc::disasm::ArchitectureType T, template<typename> typename Decoder = disasm::OpcodeTable>
+    ast::NodeList decompile(std::span<const u8> bytes) {
+        const auto instructions = disasm::decode<T, Decoder>(bytes);
+
+        return decompile<T>(bytes, instructions);
+    }
+
 }
\ No newline at end of file
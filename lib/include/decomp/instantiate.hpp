@@ -0,0 +1,29 @@
+#pragma once
+
+#include <disasm/decode.hpp>
+#include <disasm/disassembler.hpp>
+#include <decomp/decompiler.hpp>
+
+/*
+ * Explicit instantiations of the decoding, disassembling and decompiling entry points for an architecture
+ * using the default decoder. Architecture headers declare them extern with DC_EXTERN_ARCHITECTURE so only
+ * the library translation unit using DC_INSTANTIATE_ARCHITECTURE generates the code for all instructions,
+ * instead of every translation unit that includes the architecture.
+ */
+#define DC_ARCHITECTURE_INSTANCES(Prefix, Architecture)                                                                                                                                                     \
+    Prefix template dc::disasm::DecodedInstruction<Architecture> dc::disasm::decodeInstruction<Architecture, dc::disasm::OpcodeTable>(dc::u64, std::span<const dc::u8>);                                    \
+    Prefix template dc::disasm::DecodedInstruction<Architecture> dc::disasm::decodeNext<Architecture, dc::disasm::OpcodeTable>(dc::u64, std::span<const dc::u8>);                                           \
+    Prefix template std::vector<dc::disasm::DecodedInstruction<Architecture>> dc::disasm::decode<Architecture, dc::disasm::OpcodeTable>(std::span<const dc::u8>);                                           \
+    Prefix template dc::disasm::DecodedImage<Architecture> dc::disasm::decodeImage<Architecture, dc::disasm::OpcodeTable>(std::span<const dc::u8>);                                                        \
+    Prefix template void dc::disasm::disassembleInstruction<Architecture>(dc::disasm::InstructionBuffer &, const dc::disasm::DecodedInstruction<Architecture> &, std::span<const dc::u8>);                  \
+    Prefix template void dc::disasm::disassembleInstruction<Architecture>(fmt::memory_buffer &, const dc::disasm::DecodedInstruction<Architecture> &, std::span<const dc::u8>);                             \
+    Prefix template std::string dc::disasm::disassembleInstruction<Architecture>(const dc::disasm::DecodedInstruction<Architecture> &, std::span<const dc::u8>);                                            \
+    Prefix template void dc::disasm::disassemble<Architecture>(fmt::memory_buffer &, std::span<const dc::u8>, std::span<const dc::disasm::DecodedInstruction<Architecture>>);                               \
+    Prefix template void dc::disasm::disassemble<Architecture, dc::disasm::OpcodeTable>(fmt::memory_buffer &, std::span<const dc::u8>);                                                                     \
+    Prefix template std::vector<std::string> dc::disasm::disassemble<Architecture>(std::span<const dc::u8>, std::span<const dc::disasm::DecodedInstruction<Architecture>>);                                 \
+    Prefix template std::vector<std::string> dc::disasm::disassemble<Architecture, dc::disasm::OpcodeTable>(std::span<const dc::u8>);                                                                       \
+    Prefix template dc::ast::NodeList dc::decomp::decompile<Architecture>(std::span<const dc::u8>, std::span<const dc::disasm::DecodedInstruction<Architecture>>);             \
+    Prefix template dc::ast::NodeList dc::decomp::decompile<Architecture, dc::disasm::OpcodeTable>(std::span<const dc::u8>)
+
+#define DC_EXTERN_ARCHITECTURE(Architecture) DC_ARCHITECTURE_INSTANCES(extern, Architecture)
+#define DC_INSTANTIATE_ARCHITECTURE(Architecture) DC_ARCHITECTURE_INSTANCES(, Architecture)
@@ -1,128 +1,187 @@
 #pragma once
 
 #include <decomp/decompiler.hpp>
+#include <decomp/output_sink.hpp>
+#include <disasm/registers.hpp>
 #include <span>
+#include <string>
+#include <string_view>
 
 #include <ast/ast_node.hpp>
+#include <ast/flat_tree.hpp>
 
 #include <fmt/format.h>
 
 namespace dc::decomp {
 
-    class LowLevelDecompiler : public Visitor {
+    class LowLevelDecompiler final : public Visitor {
     public:
-        void visit(ast::ASTNodeIntegerLiteral &node) {
-            fmt::print("0x{:02X}", node.getValue());
+        /*
+         * All text is written to the given sink. Register and flag nodes only hold ids,
+         * their names are looked up in the tables of the decompiled architecture.
+         */
+        LowLevelDecompiler(OutputSink &output, std::span<const disasm::RegisterName> registerNames, std::span<const disasm::RegisterName> flagNames)
+            : m_output(output), m_registerNames(registerNames), m_flagNames(flagNames) { }
+
+        /* Prints a node without going through the virtual accept and visit calls */
+        void print(const ast::ASTNode &node) {
+            this->printNode(ast::PointerTree{ }, &node);
         }
 
-        void visit(ast::ASTNodeJump &node) {
-            fmt::print("goto ");
-            node.getDestination()->accept(*this);
+        /* Prints a node of a flat AST the same way as the equivalent pointer based node */
+        void print(const ast::FlatTree &tree, ast::NodeRef node) {
+            this->printNode(tree, node);
         }
 
-        void visit(ast::ASTNodeBinaryArithmetic &node) {
-            node.getLeftHandSide()->accept(*this);
-
-            switch (node.getOperator()) {
-                using enum ast::ASTNodeBinaryArithmetic::Operator;
-                case Add:                       fmt::print(" + ");  break;
-                case Subtract:                  fmt::print(" - ");  break;
-                case Multiply:                  fmt::print(" * ");  break;
-                case Divide:                    fmt::print(" / ");  break;
-                case Modulus:                   fmt::print(" % ");  break;
-                case ShiftLeftLogical:          fmt::print(" <<L "); break;
-                case ShiftRightLogical:         fmt::print(" >>L "); break;
-                case ShiftRightArithmetical:    fmt::print(" >>A "); break;
-                case RotateLeft:                fmt::print(" <<< "); break;
-                case RotateRight:               fmt::print(" >>> "); break;
-                case BoolAnd:                   fmt::print(" && "); break;
-                case BoolOr:                    fmt::print(" || "); break;
-                case BoolXor:                   fmt::print(" ^^ "); break;
-                case BitAnd:                    fmt::print(" & "); break;
-                case BitOr:                     fmt::print(" | "); break;
-                case BitXor:                    fmt::print(" ^ "); break;
-                case BoolEqual:                 fmt::print(" == "); break;
-                case BoolNotEqual:              fmt::print(" != "); break;
-                case BoolGreaterThan:           fmt::print(" > "); break;
-                case BoolLessThan:              fmt::print(" < "); break;
-                case BoolGreaterThanOrEqual:    fmt::print(" >= "); break;
-                case BoolLessThanOrEqual:       fmt::print(" <= "); break;
+        void visit(ast::ASTNodeIntegerLiteral &node)        { this->print(node); }
+        void visit(ast::ASTNodeJump &node)                  { this->print(node); }
+        void visit(ast::ASTNodeBinaryArithmetic &node)      { this->print(node); }
+        void visit(ast::ASTNodeUnaryArithmetic &node)       { this->print(node); }
+        void visit(ast::ASTNodeRegister &node)              { this->print(node); }
+        void visit(ast::ASTNodeAssignment &node)            { this->print(node); }
+        void visit(ast::ASTNodeFlag &node)                  { this->print(node); }
+        void visit(ast::ASTNodeConditional &node)           { this->print(node); }
+        void visit(ast::ASTNodeControlFlowStatement &node)  { this->print(node); }
+        void visit(ast::ASTNodeAssembly &node)              { this->print(node); }
+        void visit(ast::ASTNodeFunctionCall &node)          { this->print(node); }
+
+    private:
+        /* Printer shared by pointer based and flat ASTs, Tree is either ast::PointerTree or ast::FlatTree */
+        template<typename Tree>
+        void printNode(const Tree &tree, typename Tree::Node node) {
+            switch (tree.getKind(node)) {
+                using enum ast::NodeKind;
+                case IntegerLiteral:
+                    this->m_output.print("0x{:02X}", tree.getValue(node));
+                    break;
+                case Register:
+                    this->m_output.print("{}", this->m_registerNames[tree.getRegisterId(node)].get());
+                    break;
+                case Flag:
+                    this->m_output.print("FLAGS.{}", this->m_flagNames[tree.getFlagId(node)].get());
+                    break;
+                case Jump:
+                    this->m_output.print("goto ");
+                    this->printNode(tree, tree.getDestination(node));
+                    break;
+                case Assignment:
+                    this->printNode(tree, tree.getDestination(node));
+                    this->m_output.print(" = ");
+                    this->printNode(tree, tree.getSource(node));
+                    break;
+                case UnaryArithmetic: {
+                    this->m_output.print("{}", getOperatorString(tree.getUnaryOperator(node)));
+
+                    // Unary operators bind tighter than binary ones, so binary operands need parentheses
+                    const auto operand = tree.getOperand(node);
+                    const bool parenthesize = tree.getKind(operand) == BinaryArithmetic;
+                    if (parenthesize)
+                        this->m_output.print("(");
+
+                    this->printNode(tree, operand);
+
+                    if (parenthesize)
+                        this->m_output.print(")");
+                    break;
+                }
+                case BinaryArithmetic:
+                    this->printNode(tree, tree.getLeftHandSide(node));
+                    this->m_output.print("{}", getOperatorString(tree.getBinaryOperator(node)));
+                    this->printNode(tree, tree.getRightHandSide(node));
+                    break;
+                case Conditional: {
+                    this->m_output.print("if (");
+                    this->printNode(tree, tree.getCondition(node));
+                    this->m_output.print(") {{\n");
+                    this->printBlock(tree, tree.getTrueBlock(node));
+                    this->m_output.print("}}");
+
+                    if (const auto falseBlock = tree.getFalseBlock(node); !falseBlock.empty()) {
+                        this->m_output.print(" else {{\n");
+                        this->printBlock(tree, falseBlock);
+                        this->m_output.print("}}");
+                    }
+                    break;
+                }
+                case ControlFlowStatement:
+                    this->m_output.print("{}", getControlFlowString(tree.getControlFlowType(node)));
+                    break;
+                case Assembly:
+                    this->m_output.print("asm volatile {{ {} }}", hlp::trim(tree.getAssembly(node)));
+                    break;
+                case FunctionCall:
+                    this->m_output.print("sub_");
+                    this->printNode(tree, tree.getDestination(node));
+                    this->m_output.print("()");
+                    break;
             }
-
-            node.getRightHandSide()->accept(*this);
-
         }
 
-        void visit(ast::ASTNodeUnaryArithmetic &node) {
-            switch (node.getOperator()) {
-                using enum ast::ASTNodeUnaryArithmetic::Operator;
-                case Negate: fmt::print("-"); break;
-                case BitNot: fmt::print("~"); break;
-                case BoolNot: fmt::print("!"); break;
-                case Reference: fmt::print("&"); break;
-                case Dereference: fmt::print("*"); break;
+        template<typename Tree>
+        void printBlock(const Tree &tree, const auto &block) {
+            for (const auto &bodyNode : block) {
+                this->m_output.print("    ");
+                this->printNode(tree, bodyNode);
+                this->m_output.print("\n");
             }
-
-            node.getOperand()->accept(*this);
-
-        }
-
-        void visit(ast::ASTNodeRegister &node) {
-            fmt::print("{}", node.getRegisterName());
         }
 
-        void visit(ast::ASTNodeAssignment &node) {
-            node.getDestination()->accept(*this);
-            fmt::print(" = ");
-            node.getSource()->accept(*this);
-        }
+        static std::string_view getOperatorString(ast::ASTNodeBinaryArithmetic::Operator op) {
+            switch (op) {
+                using enum ast::ASTNodeBinaryArithmetic::Operator;
+                case Add:                       return " + ";
+                case Subtract:                  return " - ";
+                case Multiply:                  return " * ";
+                case Divide:                    return " / ";
+                case Modulus:                   return " % ";
+                case ShiftLeftLogical:          return " <<L ";
+                case ShiftRightLogical:         return " >>L ";
+                case ShiftRightArithmetical:    return " >>A ";
+                case RotateLeft:                return " <<< ";
+                case RotateRight:               return " >>> ";
+                case BoolAnd:                   return " && ";
+                case BoolOr:                    return " || ";
+                case BoolXor:                   return " ^^ ";
+                case BitAnd:                    return " & ";
+                case BitOr:                     return " | ";
+                case BitXor:                    return " ^ ";
+                case BoolEqual:                 return " == ";
+                case BoolNotEqual:              return " != ";
+                case BoolGreaterThan:           return " > ";
+                case BoolLessThan:              return " < ";
+                case BoolGreaterThanOrEqual:    return " >= ";
+                case BoolLessThanOrEqual:       return " <= ";
+            }
 
-        void visit(ast::ASTNodeFlag &node) {
-            fmt::print("FLAGS.{}", node.getFlagName());
+            return { };
         }
 
-        void visit(ast::ASTNodeConditional &node) {
-            fmt::print("if (");
-            node.getCondition()->accept(*this);
-            fmt::print(") {{\n");
-
-            for (auto &bodyNode : node.getTrueBlock()) {
-                fmt::print("    ");
-                bodyNode->accept(*this);
-                fmt::print("\n");
+        static std::string_view getOperatorString(ast::ASTNodeUnaryArithmetic::Operator op) {
+            switch (op) {
+                using enum ast::ASTNodeUnaryArithmetic::Operator;
+                case Negate: return "-";
+                case BitNot: return "~";
+                case BoolNot: return "!";
+                case Reference: return "&";
+                case Dereference: return "*";
             }
 
-            fmt::print("}}");
-            if (const auto &falseBody = node.getFalseBlock(); !falseBody.empty()) {
-                fmt::print(" else {{\n");
-                for (auto &bodyNode : falseBody) {
-                    fmt::print("    ");
-                    bodyNode->accept(*this);
-                    fmt::print("\n");
-                }
-                fmt::print("}}");
-            }
+            return { };
         }
 
-        void visit(ast::ASTNodeControlFlowStatement &node) {
-            switch (node.getType()) {
+        static std::string_view getControlFlowString(ast::ASTNodeControlFlowStatement::Type type) {
+            switch (type) {
                 using enum ast::ASTNodeControlFlowStatement::Type;
-                case Return: fmt::print("return"); break;
-                case Break: fmt::print("break"); break;
-                case Continue: fmt::print("continue"); break;
+                case Return: return "return";
+                case Break: return "break";
+                case Continue: return "continue";
             }
-        }
-
-        void visit(ast::ASTNodeAssembly &node) {
-            fmt::print("asm volatile {{ {} }}", hlp::trim(node.getAssembly()));
-        }
 
-        void visit(ast::ASTNodeFunctionCall &node) {
-            fmt::print("sub_");
-            node.getDestination()->accept(*this);
-            fmt::print("()");
+            return { };
         }
 
+        OutputSink &m_output;
+        std::span<const disasm::RegisterName> m_registerNames, m_flagNames;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <dc.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace dc::decomp {
+
+    /*
+     * Destination for the text produced by a decompiler. Text is collected in a buffer owned by the sink
+     * and only handed to write() in large chunks once the buffer is full or the sink gets flushed.
+     * A sink isn't thread safe, every thread needs its own one.
+     */
+    class OutputSink {
+    public:
+        constexpr static size_t FlushThreshold = 64 * 1024;
+
+        OutputSink() = default;
+        virtual ~OutputSink() = default;
+
+        OutputSink(const OutputSink &) = delete;
+        OutputSink &operator=(const OutputSink &) = delete;
+
+        template<typename ... Args>
+        void print(fmt::format_string<Args...> format, Args && ... args) {
+            fmt::format_to(fmt::appender(this->m_buffer), format, std::forward<Args>(args)...);
+
+            if (this->m_buffer.size() >= FlushThreshold)
+                this->flush();
+        }
+
+        void flush() {
+            if (this->m_buffer.size() == 0)
+                return;
+
+            this->write({ this->m_buffer.data(), this->m_buffer.size() });
+            this->m_buffer.clear();
+        }
+
+    protected:
+        virtual void write(std::string_view text) = 0;
+
+    private:
+        fmt::memory_buffer m_buffer;
+    };
+
+    /*
+     * Keeps all text in memory
+     */
+    class MemorySink final : public OutputSink {
+    public:
+        [[nodiscard]] const std::string& getText() {
+            this->flush();
+            return this->m_text;
+        }
+
+        void clear() {
+            this->flush();
+            this->m_text.clear();
+        }
+
+    protected:
+        void write(std::string_view text) override {
+            this->m_text.append(text);
+        }
+
+    private:
+        std::string m_text;
+    };
+
+    /*
+     * Writes text to a C stream such as stdout or a file opened with fopen or fdopen
+     */
+    class FileSink final : public OutputSink {
+    public:
+        explicit FileSink(std::FILE *file = stdout) : m_file(file) { }
+        ~FileSink() override { this->flush(); }
+
+    protected:
+        void write(std::string_view text) override {
+            std::fwrite(text.data(), sizeof(char), text.size(), this->m_file);
+        }
+
+    private:
+        std::FILE *m_file;
+    };
+
+    /*
+     * Passes chunks of text on to a user provided function
+     */
+    class CallbackSink final : public OutputSink {
+    public:
+        explicit CallbackSink(std::function<void(std::string_view)> callback) : m_callback(std::move(callback)) { }
+        ~CallbackSink() override { this->flush(); }
+
+    protected:
+        void write(std::string_view text) override {
+            this->m_callback(text);
+        }
+
+    private:
+        std::function<void(std::string_view)> m_callback;
+    };
+
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <dc.hpp>
+#include <helpers/bit_pattern.hpp>
+#include <helpers/type_array.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+namespace dc::disasm::arm::v7::thumb {
+
+    /*
+     * Top level encoding groups of 16 bit Thumb instructions, as laid out in the ARMv7-M opcode tables
+     */
+    enum class Group : u8 {
+        Unknown = 0,
+        ShiftAddSubtractMoveCompare,
+        DataProcessing,
+        SpecialDataBranchExchange,
+        LoadLiteral,
+        LoadStoreSingle,
+        GenerateAddress,
+        Miscellaneous,
+        LoadStoreMultiple,
+        ConditionalBranchSupervisorCall,
+        UnconditionalBranch,
+        Wide
+    };
+
+    namespace {
+
+        template<hlp::StaticString PatternValue, Group GroupValue>
+        struct GroupEncoding {
+            using Pattern = hlp::BitPattern<PatternValue, std::endian::little>;
+            constexpr static auto Value = GroupValue;
+        };
+
+        struct GroupMask {
+            u16 mask, compareValue;
+            Group group;
+        };
+
+        template<typename ... Encodings>
+        consteval auto getGroupMasks() {
+            return std::array<GroupMask, sizeof...(Encodings)> {
+                GroupMask { u16(Encodings::Pattern::getBitMaskWord()), u16(Encodings::Pattern::getBitCompareValueWord()), Encodings::Value }...
+            };
+        }
+
+        constexpr auto GroupMasks = getGroupMasks<
+                GroupEncoding<"00xx'xxxx'xxxx'xxxx", Group::ShiftAddSubtractMoveCompare>,
+                GroupEncoding<"0100'00xx'xxxx'xxxx", Group::DataProcessing>,
+                GroupEncoding<"0100'01xx'xxxx'xxxx", Group::SpecialDataBranchExchange>,
+                GroupEncoding<"0100'1xxx'xxxx'xxxx", Group::LoadLiteral>,
+                GroupEncoding<"0101'xxxx'xxxx'xxxx", Group::LoadStoreSingle>,
+                GroupEncoding<"011x'xxxx'xxxx'xxxx", Group::LoadStoreSingle>,
+                GroupEncoding<"100x'xxxx'xxxx'xxxx", Group::LoadStoreSingle>,
+                GroupEncoding<"1010'xxxx'xxxx'xxxx", Group::GenerateAddress>,
+                GroupEncoding<"1011'xxxx'xxxx'xxxx", Group::Miscellaneous>,
+                GroupEncoding<"1100'xxxx'xxxx'xxxx", Group::LoadStoreMultiple>,
+                GroupEncoding<"1101'xxxx'xxxx'xxxx", Group::ConditionalBranchSupervisorCall>,
+                GroupEncoding<"1110'0xxx'xxxx'xxxx", Group::UnconditionalBranch>,
+                GroupEncoding<"1110'1xxx'xxxx'xxxx", Group::Wide>,
+                GroupEncoding<"1111'xxxx'xxxx'xxxx", Group::Wide>
+        >();
+
+        /* Groups are told apart by the upper byte only, so checking all 256 upper bytes covers every halfword */
+        consteval bool isExactCover() {
+            for (u32 upperByte = 0x00; upperByte <= 0xFF; upperByte++) {
+                const auto count = std::count_if(GroupMasks.begin(), GroupMasks.end(), [halfword = upperByte << 8](const auto &group) {
+                    return (group.mask & 0x00FF) == 0x00 && (halfword & group.mask) == group.compareValue;
+                });
+
+                if (count != 1)
+                    return false;
+            }
+
+            return true;
+        }
+
+        static_assert(isExactCover(), "Every halfword needs to belong to exactly one group");
+
+        consteval auto generateGroupTable() {
+            std::array<Group, 256> result = { };
+
+            for (u32 upperByte = 0x00; upperByte <= 0xFF; upperByte++) {
+                for (const auto &group : GroupMasks) {
+                    if (((upperByte << 8) & group.mask) == group.compareValue)
+                        result[upperByte] = group.group;
+                }
+            }
+
+            return result;
+        }
+
+        /* Group of every possible upper byte of a halfword */
+        constexpr auto GroupTable = generateGroupTable();
+
+        inline u16 loadHalfword(const u8 *data) {
+            u16 halfword;
+            std::memcpy(&halfword, data, sizeof(halfword));
+
+            if constexpr (std::endian::native == std::endian::big)
+                halfword = hlp::byteSwap(halfword);
+
+            return halfword;
+        }
+
+        /*
+         * As the groups don't overlap, every halfword matches exactly one group mask. OR-ing together the group values
+         * of all matching masks therefore gives the halfword's group without any ordering between the comparisons.
+         */
+        #if defined(__AVX2__)
+
+            inline void classify16(const u8 *data, Group *groups) {
+                const auto halfwords = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+
+                auto result = _mm256_setzero_si256();
+                [&]<size_t ... Is>(std::index_sequence<Is...>) {
+                    ((result = _mm256_or_si256(result, _mm256_and_si256(
+                        _mm256_cmpeq_epi16(_mm256_and_si256(halfwords, _mm256_set1_epi16(i16(GroupMasks[Is].mask))), _mm256_set1_epi16(i16(GroupMasks[Is].compareValue))),
+                        _mm256_set1_epi16(i16(GroupMasks[Is].group))
+                    ))), ...);
+                }(std::make_index_sequence<GroupMasks.size()>());
+
+                const auto packed = _mm_packus_epi16(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(groups), packed);
+            }
+
+        #endif
+
+        #if defined(__SSE2__)
+
+            inline void classify8(const u8 *data, Group *groups) {
+                const auto halfwords = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+                auto result = _mm_setzero_si128();
+                [&]<size_t ... Is>(std::index_sequence<Is...>) {
+                    ((result = _mm_or_si128(result, _mm_and_si128(
+                        _mm_cmpeq_epi16(_mm_and_si128(halfwords, _mm_set1_epi16(i16(GroupMasks[Is].mask))), _mm_set1_epi16(i16(GroupMasks[Is].compareValue))),
+                        _mm_set1_epi16(i16(GroupMasks[Is].group))
+                    ))), ...);
+                }(std::make_index_sequence<GroupMasks.size()>());
+
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(groups), _mm_packus_epi16(result, result));
+            }
+
+        #endif
+
+    }
+
+    [[nodiscard]]
+    constexpr Group classify(u16 halfword) {
+        return GroupTable[halfword >> 8];
+    }
+
+    /*
+     * Classifies every halfword of the input into its encoding group, 16 or 8 halfwords at a time where the target supports it.
+     * groups needs room for one entry per complete halfword in bytes. Halfwords following a Wide prefix are classified as well,
+     * it's up to the caller to skip them.
+     */
+    inline void classify(std::span<const u8> bytes, std::span<Group> groups) {
+        const size_t count = std::min(bytes.size() / sizeof(u16), groups.size());
+        const u8 *data = bytes.data();
+
+        size_t index = 0;
+
+        if constexpr (std::endian::native == std::endian::little) {
+            #if defined(__AVX2__)
+                for (; index + 16 <= count; index += 16)
+                    classify16(data + index * sizeof(u16), groups.data() + index);
+            #endif
+
+            #if defined(__SSE2__)
+                for (; index + 8 <= count; index += 8)
+                    classify8(data + index * sizeof(u16), groups.data() + index);
+            #endif
+        }
+
+        for (; index < count; index++)
+            groups[index] = classify(loadHalfword(data + index * sizeof(u16)));
+    }
+
+    [[nodiscard]]
+    inline std::vector<Group> classify(std::span<const u8> bytes) {
+        std::vector<Group> groups(bytes.size() / sizeof(u16));
+        classify(bytes, groups);
+
+        return groups;
+    }
+
+    /*
+     * Decoder that classifies a halfword into its encoding group first and then only tests the instructions of that group.
+     * Which group an instruction belongs to is derived from its pattern. Every instruction has to lie entirely within
+     * a single group mask, so the hand written group masks can't drift apart from the instruction patterns unnoticed.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    class GroupedDecoder {
+    public:
+        constexpr static size_t NotFound = T::Size;
+
+        [[nodiscard]]
+        static size_t find(std::span<const u8> bytes) {
+            if (bytes.size() < sizeof(u16))
+                return NotFound;
+
+            const auto halfword = u16(T::template Get<0>::Pattern::loadWord(bytes));
+
+            return findInGroup(halfword, classify(halfword));
+        }
+
+        /*
+         * Looks up the instruction at every halfword of the input. The halfwords are classified in batches using SIMD
+         * before their groups' candidates are tested. indices needs room for one entry per complete halfword in bytes.
+         */
+        static void findAll(std::span<const u8> bytes, std::span<u16> indices) {
+            constexpr size_t BatchSize = 256;
+            std::array<Group, BatchSize> groups;
+
+            const size_t count = std::min(bytes.size() / sizeof(u16), indices.size());
+            for (size_t begin = 0; begin < count; begin += BatchSize) {
+                const auto batchCount = std::min(BatchSize, count - begin);
+                const auto batchBytes = bytes.subspan(begin * sizeof(u16), batchCount * sizeof(u16));
+
+                classify(batchBytes, groups);
+                for (size_t i = 0; i < batchCount; i++)
+                    indices[begin + i] = u16(findInGroup(loadHalfword(batchBytes.data() + i * sizeof(u16)), groups[i]));
+            }
+        }
+
+        [[nodiscard]]
+        constexpr static size_t getCandidateCount(Group group) {
+            return Table.offsets[size_t(group) + 1] - Table.offsets[size_t(group)];
+        }
+
+    private:
+        struct Candidate {
+            u16 mask, compareValue, index;
+        };
+
+        constexpr static size_t GroupCount = size_t(Group::Wide) + 1;
+
+        static size_t findInGroup(u16 halfword, Group group) {
+            for (u32 i = Table.offsets[size_t(group)]; i < Table.offsets[size_t(group) + 1]; i++) {
+                const auto &candidate = Table.candidates[i];
+                if ((halfword & candidate.mask) == candidate.compareValue)
+                    return candidate.index;
+            }
+
+            return NotFound;
+        }
+
+        template<typename ... Instrs, size_t ... Is>
+        consteval static auto getCandidates(const hlp::TypeArray<Instrs...> &, std::index_sequence<Is...>) {
+            return std::array<Candidate, T::Size> {
+                Candidate { u16(Instrs::Pattern::getBitMaskWord()), u16(Instrs::Pattern::getBitCompareValueWord()), u16(Is) }...
+            };
+        }
+
+        /* Group whose mask covers every halfword the candidate can match, Unknown if its halfwords are spread over several group masks */
+        consteval static Group getContainingGroup(const Candidate &candidate) {
+            Group result = Group::Unknown;
+            size_t overlapping = 0;
+
+            for (const auto &group : GroupMasks) {
+                if (((candidate.compareValue ^ group.compareValue) & group.mask & candidate.mask) != 0)
+                    continue;
+
+                overlapping++;
+                if ((group.mask & ~candidate.mask) == 0)
+                    result = group.group;
+            }
+
+            return overlapping == 1 ? result : Group::Unknown;
+        }
+
+        consteval static bool isEveryInstructionInOneGroup() {
+            for (const auto &candidate : Candidates) {
+                if (getContainingGroup(candidate) == Group::Unknown)
+                    return false;
+            }
+
+            return true;
+        }
+
+        /* Candidates of each group in InstructionArray order, the ones of group g are found from offsets[g] to offsets[g + 1] */
+        consteval static auto generateTable() {
+            struct {
+                std::array<u16, GroupCount + 1> offsets;
+                std::array<Candidate, T::Size> candidates;
+            } result = { };
+
+            size_t count = 0;
+            for (size_t group = 0; group < GroupCount; group++) {
+                result.offsets[group] = u16(count);
+
+                for (const auto &candidate : Candidates) {
+                    if (size_t(getContainingGroup(candidate)) == group)
+                        result.candidates[count++] = candidate;
+                }
+            }
+            result.offsets[GroupCount] = u16(count);
+
+            return result;
+        }
+
+        template<typename ... Instrs>
+        consteval static bool isHalfwordWidth(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getByteCount() == sizeof(u16) && Instrs::Pattern::getEndian() == std::endian::little) && ...);
+        }
+
+        static_assert(isHalfwordWidth(T{ }), "Grouped decoding requires all instructions to be little endian halfwords");
+        static_assert(T::Size <= std::numeric_limits<u16>::max(), "Too many instructions for grouped decoding");
+
+        constexpr static auto Candidates = getCandidates(T{ }, std::make_index_sequence<T::Size>());
+
+        static_assert(isEveryInstructionInOneGroup(), "Every instruction needs to lie within exactly one encoding group");
+
+        constexpr static auto Table = generateTable();
+    };
+
+}
@@ -2,6 +2,9 @@
 
 #include <tuple>
 #include <disasm/instruction.hpp>
+#include <disasm/pattern_order.hpp>
+#include <disasm/registers.hpp>
+#include <decomp/instantiate.hpp>
 
 namespace dc::disasm::arm::v7::thumb {
 
@@ -16,81 +19,74 @@ namespace dc::disasm::arm::v7::thumb {
 
         template<auto First, auto ... Rest>
         static constexpr auto Deref() {
-            return [](const auto &bytes) { return fmt::format("{}", formatImpl<First, Rest...>(bytes)); };
+            return makeOperand<joinFormats<First, Rest...>()>([](const auto &bytes) {
+                return std::tuple_cat(First().getValues(bytes), Rest().getValues(bytes)...);
+            });
         }
 
         template<typename Placeholder>
         constexpr static auto R() {
-            return [](const auto &bytes) { return fmt::format("R{}", Placeholder::get(bytes)); };
+            return makeOperand<"R{}">([](const auto &bytes) { return std::tuple(Placeholder::get(bytes)); });
         }
 
         template<typename Placeholder>
         constexpr static auto RWriteBack() {
-            return [](const auto &bytes) { return fmt::format("R{}!", Placeholder::get(bytes)); };
+            return makeOperand<"R{}!">([](const auto &bytes) { return std::tuple(Placeholder::get(bytes)); });
         }
 
         constexpr static auto SP() {
-            return [](const auto &) { return "SP"; };
+            return makeOperand<"SP">([](const auto &) { return std::tuple(); });
         }
 
         constexpr static auto PC() {
-            return [](const auto &) { return "PC"; };
+            return makeOperand<"PC">([](const auto &) { return std::tuple(); });
         }
 
         constexpr static auto None() {
-            return [](const auto &) { return ""; };
+            return makeOperand<"">([](const auto &) { return std::tuple(); });
         }
 
         template<typename Placeholder, size_t Shift = 0>
         constexpr static auto Imm() {
-            return [](const auto &bytes) { return fmt::format("#{}", Placeholder::get(bytes) << Shift); };
+            return makeOperand<"#{}">([](const auto &bytes) { return std::tuple(Placeholder::get(bytes) << Shift); });
         }
 
         template<u32 Value>
         constexpr static auto Imm() {
-            return [](const auto &bytes) { return fmt::format("#{}", Value); };
+            return makeOperand<"#{}">([](const auto &) { return std::tuple(Value); });
         }
 
         template<typename Placeholder, size_t Size, size_t Shift = 0>
         constexpr static auto ImmSigned() {
-            return [](const auto &bytes) {
+            return makeOperand<"#{}">([](const auto &bytes) {
                 i64 value = Placeholder::get(bytes) << Shift;
                 if ((value & (1 << (Size - 1))) != 0)
                     value = (std::numeric_limits<u64>::max() << Size) | value;
 
-                return fmt::format("#{}", value);
-            };
+                return std::tuple(value);
+            });
         }
 
+        constexpr static std::array<std::string_view, 16> ConditionNames = {
+            "EQ", "NE", "CS", "CC", "MI", "PL", "VS", "VC", "HI", "LS", "GE", "LT", "GT", "LE", "", ""
+        };
+
         template<typename Placeholder>
         constexpr static auto Cond() {
-            return [](const auto &bytes) {
-                auto cond = Placeholder::get(bytes);
-
-                switch (cond) {
-                    case 0b0000: return "EQ";
-                    case 0b0001: return "NE";
-                    case 0b0010: return "CS";
-                    case 0b0011: return "CC";
-                    case 0b0100: return "MI";
-                    case 0b0101: return "PL";
-                    case 0b0110: return "VS";
-                    case 0b0111: return "VC";
-                    case 0b1000: return "HI";
-                    case 0b1001: return "LS";
-                    case 0b1010: return "GE";
-                    case 0b1011: return "LT";
-                    case 0b1100: return "GT";
-                    case 0b1101: return "LE";
-                    case 0b1110: return "";
-                    default: return "";
-                }
-            };
+            return makeOperand<"{}">([](const auto &bytes) { return std::tuple(ConditionNames[Placeholder::get(bytes) & 0b1111]); });
         }
 
+        /*
+         * The format strings of the mnemonic and all operands are joined at compile time, so the whole
+         * instruction is written by a single call to format_to
+         */
         template<auto First = None, auto ... Rest>
-        static constexpr auto format(const auto &bytes) {
-            return fmt::format("{} {}", Parent::Mnemonic, formatImpl<First, Rest...>(bytes));
+        static void format(fmt::appender out, const auto &bytes) {
+            constexpr auto Format = hlp::StaticString("{} ") + joinFormats<First, Rest...>();
+
+            std::apply([out](const auto &... values) {
+                fmt::format_to(out, CompiledFormatString<Format>(), Parent::Mnemonic, values...);
+            }, std::tuple_cat(First().getValues(bytes), Rest().getValues(bytes)...));
         }
 
         constexpr static std::string disassemble(u64 address, std::span<const u8> bytes) {
@@ -99,11 +95,8 @@ namespace dc::disasm::arm::v7::thumb {
 
     private:
         template<auto First, auto ... Rest>
-        static constexpr auto formatImpl(const auto &bytes) {
-            if constexpr (sizeof...(Rest) > 0)
-                return fmt::format("{}, {}", First()(bytes), formatImpl<Rest...>(bytes));
-            else
-                return fmt::format("{}", First()(bytes));
+        consteval static auto joinFormats() {
+            return (decltype(First())::Format + ... + (hlp::StaticString(", ") + decltype(Rest())::Format));
         }
     };
 
@@ -111,11 +104,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        constexpr static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<m>, R<dn>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<m>, R<dn>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -125,11 +118,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using d    = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<n>, Imm<imm3>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<n>, Imm<imm3>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -138,11 +131,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm8 = Placeholder<'i'>;
         using dn   = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, Imm<imm8>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, Imm<imm8>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -152,11 +145,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<m>, R<n>, R<d>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<m>, R<n>, R<d>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -165,11 +158,11 @@ namespace dc::disasm::arm::v7::thumb {
         using dn = Placeholder<'n'>;
         using m  = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -178,11 +171,11 @@ namespace dc::disasm::arm::v7::thumb {
         using d    = Placeholder<'d'>;
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, SP, Imm<imm8, 2>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, SP, Imm<imm8, 2>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -190,11 +183,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrADDSPImmediateT2 : public InstructionARM<"add", "1011'0000'0'iiiiiii"> {
         using imm7 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<SP, SP, Imm<imm7, 2>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<SP, SP, Imm<imm7, 2>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -202,11 +195,14 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrADDSPRegisterT1 : public InstructionARM<"add", "01000100'm'1101'mmm"> {
         using dm = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dm>, SP, R<dm>>(bytes);
+        /* T2 encodings with Rm == SP are decoded as T1 */
+        constexpr static auto Priority = 1;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dm>, SP, R<dm>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -214,11 +210,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrADDSPRegisterT2 : public InstructionARM<"add", "01000100'1'mmmm'101"> {
         using m = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<SP, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<SP, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -227,11 +223,11 @@ namespace dc::disasm::arm::v7::thumb {
         using d    = Placeholder<'d'>;
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, Imm<imm8, 2>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, Imm<imm8, 2>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -240,11 +236,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -254,11 +250,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m    = Placeholder<'m'>;
         using d    = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>, Imm<imm5>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>, Imm<imm5>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -267,11 +263,11 @@ namespace dc::disasm::arm::v7::thumb {
         using dn = Placeholder<'n'>;
         using m  = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -280,11 +276,11 @@ namespace dc::disasm::arm::v7::thumb {
         using cond = Placeholder<'c'>;
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<Cond<cond>, ImmSigned<imm8, 8, 1>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<Cond<cond>, ImmSigned<imm8, 8, 1>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -292,11 +288,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrBT2 : public InstructionARM<"b", "11100'iiiiiiiiiii"> {
         using imm11 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<ImmSigned<imm11, 11, 1>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<ImmSigned<imm11, 11, 1>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -305,11 +301,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -317,11 +313,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrBKPT : public InstructionARM<"bkpt", "1011'1110'iiiiiiii"> {
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<Imm<imm8>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<Imm<imm8>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -329,11 +325,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrBLX : public InstructionARM<"blx", "010001'11'1'mmmm'xxx"> {
         using m = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -341,11 +337,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrBX : public InstructionARM<"bx", "010001'11'0'mmmm'xxx"> {
         using m = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -354,11 +350,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm6 = Placeholder<'i'>;
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<n>, Imm<imm6, 1>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<n>, Imm<imm6, 1>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -367,11 +363,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm6 = Placeholder<'i'>;
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<n>, Imm<imm6, 1>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<n>, Imm<imm6, 1>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -380,11 +376,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<m>, R<n>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<m>, R<n>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -393,11 +389,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<n>, Imm<imm8>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<n>, Imm<imm8>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -406,11 +402,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<n>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<n>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -419,11 +415,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<n>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<n>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -435,23 +431,22 @@ namespace dc::disasm::arm::v7::thumb {
 
         using enable = Placeholder<'e'>;
 
-        static auto formatFlags(const auto &bytes) {
-            std::string result;
+        static void formatFlags(fmt::appender out, const auto &bytes) {
             if (a::get(bytes))
-                result += 'a';
+                fmt::format_to(out, FMT_COMPILE("a"));
             if (i::get(bytes))
-                result += 'i';
+                fmt::format_to(out, FMT_COMPILE("i"));
             if (f::get(bytes))
-                result += 'f';
-
-            return result;
+                fmt::format_to(out, FMT_COMPILE("f"));
         }
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes) + (enable::get(bytes) == 0 ? "IE" : "ID") + formatFlags(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
+            fmt::format_to(out, FMT_COMPILE("{}"), enable::get(bytes) == 0 ? "IE" : "ID");
+            formatFlags(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -460,11 +455,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -473,12 +468,12 @@ namespace dc::disasm::arm::v7::thumb {
         using cond = Placeholder<'c'>;
         using mask = Placeholder<'m'>;
 
-        static auto formatMask(const auto &bytes) {
+        static void formatMask(fmt::appender out, const auto &bytes) {
             const bool firstCond0 = cond::get(bytes) & 0b0001;
             const auto maskValue = mask::get(bytes);
 
             if ((maskValue & 0b1111) == 0b1000)
-                return std::string();
+                return;
 
             bool x = false, y = false, z = false;
 
@@ -498,19 +493,18 @@ namespace dc::disasm::arm::v7::thumb {
                 z = true;
             }
 
-            std::string result;
-            if (x) result += firstCond0 ? "T" : "E";
-            if (y) result += firstCond0 ? "T" : "E";
-            if (z) result += firstCond0 ? "T" : "E";
-
-            return result;
+            if (x) fmt::format_to(out, FMT_COMPILE("{}"), firstCond0 ? "T" : "E");
+            if (y) fmt::format_to(out, FMT_COMPILE("{}"), firstCond0 ? "T" : "E");
+            if (z) fmt::format_to(out, FMT_COMPILE("{}"), firstCond0 ? "T" : "E");
         }
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes) + formatMask(bytes) + Cond<cond>()(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
+            formatMask(out, bytes);
+            Cond<cond>()(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -519,30 +513,30 @@ namespace dc::disasm::arm::v7::thumb {
         using register_list = Placeholder<'r'>;
         using n = Placeholder<'n'>;
 
-        static auto formatRegisterList(const auto &bytes) {
-            std::string result = "{ ";
-
+        static void formatRegisterList(fmt::appender out, const auto &bytes) {
             auto registers = register_list::get(bytes);
 
+            const char *separator = "{ ";
             for (u8 i = 0; i < 8; i++) {
-                if ((registers & (1 << i)) != 0x00)
-                    result += fmt::format("R{}, ", i);
+                if ((registers & (1 << i)) != 0x00) {
+                    fmt::format_to(out, FMT_COMPILE("{}R{}"), separator, i);
+                    separator = ", ";
+                }
             }
 
-            result.pop_back();
-            result.pop_back();
-
-            return result + " }";
+            fmt::format_to(out, FMT_COMPILE("{}"), registers == 0x00 ? "{ }" : " }");
         }
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
             if (register_list::get(bytes) & (1 << n::get(bytes)))
-                return format<RWriteBack<n>>(bytes) + formatRegisterList(bytes);
+                format<RWriteBack<n>>(out, bytes);
             else
-                return format<R<n>>(bytes) + formatRegisterList(bytes);
+                format<R<n>>(out, bytes);
+
+            formatRegisterList(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -552,11 +546,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, Imm<imm5, 2>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, Imm<imm5, 2>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -565,11 +559,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm8 = Placeholder<'i'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<SP, Imm<imm8, 2>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<SP, Imm<imm8, 2>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -578,11 +572,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm8 = Placeholder<'i'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Imm<imm8, 2>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Imm<imm8, 2>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -592,11 +586,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -606,11 +600,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, Imm<imm5>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, Imm<imm5>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -620,11 +614,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -634,11 +628,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, Imm<imm5, 1>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, Imm<imm5, 1>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -648,11 +642,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -662,11 +656,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -676,11 +670,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -690,11 +684,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m    = Placeholder<'m'>;
         using d    = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>, Imm<imm5>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>, Imm<imm5>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -703,11 +697,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -717,11 +711,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m    = Placeholder<'m'>;
         using d    = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>, Imm<imm5>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>, Imm<imm5>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -730,11 +724,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -743,11 +737,11 @@ namespace dc::disasm::arm::v7::thumb {
         using d    = Placeholder<'d'>;
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, Imm<imm8>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, Imm<imm8>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -756,11 +750,11 @@ namespace dc::disasm::arm::v7::thumb {
         using d = Placeholder<'d'>;
         using m = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -769,11 +763,11 @@ namespace dc::disasm::arm::v7::thumb {
         using d = Placeholder<'d'>;
         using m = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -782,11 +776,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n  = Placeholder<'n'>;
         using dm = Placeholder<'m'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dm>, R<n>, R<dm>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dm>, R<n>, R<dm>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -795,21 +789,21 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
 
     struct InstrNOP : public InstructionARM<"nop", "1011'1111'0000'0000"> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -818,11 +812,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -831,31 +825,32 @@ namespace dc::disasm::arm::v7::thumb {
         using P = Placeholder<'p'>;
         using register_list = Placeholder<'r'>;
 
-        static auto formatRegisterList(const auto &bytes) {
-            std::string result = "{ ";
-
+        static void formatRegisterList(fmt::appender out, const auto &bytes) {
             auto registers = register_list::get(bytes);
             auto pc = P::get(bytes);
 
+            const char *separator = "{ ";
             for (u8 i = 0; i < 8; i++) {
-                if ((registers & (1 << i)) != 0x00)
-                    result += fmt::format("R{}, ", i);
+                if ((registers & (1 << i)) != 0x00) {
+                    fmt::format_to(out, FMT_COMPILE("{}R{}"), separator, i);
+                    separator = ", ";
+                }
             }
 
-            if (pc)
-                result += "PC, ";
-
-            result.pop_back();
-            result.pop_back();
+            if (pc) {
+                fmt::format_to(out, FMT_COMPILE("{}PC"), separator);
+                separator = ", ";
+            }
 
-            return result + " }";
+            fmt::format_to(out, FMT_COMPILE("{}"), separator[0] == '{' ? "{ }" : " }");
         }
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes) + formatRegisterList(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
+            formatRegisterList(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -864,31 +859,32 @@ namespace dc::disasm::arm::v7::thumb {
         using M = Placeholder<'m'>;
         using register_list = Placeholder<'r'>;
 
-        static auto formatRegisterList(const auto &bytes) {
-            std::string result = "{ ";
-
+        static void formatRegisterList(fmt::appender out, const auto &bytes) {
             auto registers = register_list::get(bytes);
             auto lr = M::get(bytes);
 
+            const char *separator = "{ ";
             for (u8 i = 0; i < 8; i++) {
-                if ((registers & (1 << i)) != 0x00)
-                    result += fmt::format("R{}, ", i);
+                if ((registers & (1 << i)) != 0x00) {
+                    fmt::format_to(out, FMT_COMPILE("{}R{}"), separator, i);
+                    separator = ", ";
+                }
             }
 
-            if (lr)
-                result += "LR, ";
-
-            result.pop_back();
-            result.pop_back();
+            if (lr) {
+                fmt::format_to(out, FMT_COMPILE("{}LR"), separator);
+                separator = ", ";
+            }
 
-            return result + " }";
+            fmt::format_to(out, FMT_COMPILE("{}"), separator[0] == '{' ? "{ }" : " }");
         }
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes) + formatRegisterList(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
+            formatRegisterList(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -897,11 +893,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -910,11 +906,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -923,11 +919,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -936,11 +932,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -949,11 +945,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<n>, Imm<0>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<n>, Imm<0>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -962,21 +958,21 @@ namespace dc::disasm::arm::v7::thumb {
         using m  = Placeholder<'m'>;
         using dn = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
 
     struct InstrSEV : public InstructionARM<"sev", "1011'1111'0100'0000"> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -985,30 +981,30 @@ namespace dc::disasm::arm::v7::thumb {
         using register_list = Placeholder<'r'>;
         using n = Placeholder<'n'>;
 
-        static auto formatRegisterList(const auto &bytes) {
-            std::string result = "{ ";
-
+        static void formatRegisterList(fmt::appender out, const auto &bytes) {
             auto registers = register_list::get(bytes);
 
+            const char *separator = "{ ";
             for (u8 i = 0; i < 8; i++) {
-                if ((registers & (1 << i)) != 0x00)
-                    result += fmt::format("R{}, ", i);
+                if ((registers & (1 << i)) != 0x00) {
+                    fmt::format_to(out, FMT_COMPILE("{}R{}"), separator, i);
+                    separator = ", ";
+                }
             }
 
-            result.pop_back();
-            result.pop_back();
-
-            return result + " }";
+            fmt::format_to(out, FMT_COMPILE("{}"), registers == 0x00 ? "{ }" : " }");
         }
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
             if (register_list::get(bytes) & (1 << n::get(bytes)))
-                return format<RWriteBack<n>>(bytes) + formatRegisterList(bytes);
+                format<RWriteBack<n>>(out, bytes);
             else
-                return format<R<n>>(bytes) + formatRegisterList(bytes);
+                format<R<n>>(out, bytes);
+
+            formatRegisterList(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1018,11 +1014,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, Imm<imm5, 2>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, Imm<imm5, 2>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1031,11 +1027,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm8 = Placeholder<'i'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<SP, Imm<imm8, 2>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<SP, Imm<imm8, 2>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1045,11 +1041,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1059,11 +1055,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, Imm<imm5>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, Imm<imm5>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1073,11 +1069,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1087,11 +1083,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using t    = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, Imm<imm5, 1>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, Imm<imm5, 1>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1101,11 +1097,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using t = Placeholder<'t'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<t>, Deref<R<n>, R<m>>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<t>, Deref<R<n>, R<m>>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1115,11 +1111,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n    = Placeholder<'n'>;
         using d    = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<n>, Imm<imm3>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<n>, Imm<imm3>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1128,11 +1124,11 @@ namespace dc::disasm::arm::v7::thumb {
         using imm8 = Placeholder<'i'>;
         using dn   = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<dn>, Imm<imm8>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<dn>, Imm<imm8>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1142,11 +1138,11 @@ namespace dc::disasm::arm::v7::thumb {
         using n = Placeholder<'n'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<n>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<n>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1154,11 +1150,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrSUBSPMinusImmediate : public InstructionARM<"sub", "1011'0000'1'iiiiiii"> {
         using imm7 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<SP, SP, Imm<imm7, 2>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<SP, SP, Imm<imm7, 2>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1166,11 +1162,11 @@ namespace dc::disasm::arm::v7::thumb {
     struct InstrSVC : public InstructionARM<"svc", "1101'1111'iiiiiiii"> {
         using imm8 = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<Imm<imm8>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<Imm<imm8>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1179,11 +1175,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1192,11 +1188,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1205,11 +1201,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<n>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<n>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1218,11 +1214,11 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -1231,49 +1227,64 @@ namespace dc::disasm::arm::v7::thumb {
         using m = Placeholder<'m'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format<R<d>, R<m>>(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format<R<d>, R<m>>(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
 
     struct InstrWFE : public InstructionARM<"wfe", "1011'1111'0010'0000"> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
 
     struct InstrWFI : public InstructionARM<"wfi", "1011'1111'0011'0000"> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
 
     struct InstrYIELD : public InstructionARM<"yield", "1011'1111'0001'0000"> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return format(bytes);
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            format(out, bytes);
         }
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
 
+    consteval auto generateRegisterNames() {
+        RegisterTable<16> result;
+
+        for (u32 reg = 0; reg < 13; reg++)
+            result[reg] = RegisterName("R").appendDecimal(reg);
+        result[13] = "SP";
+        result[14] = "LR";
+        result[15] = "PC";
+
+        return result;
+    }
+
     struct Architecture {
         constexpr static auto InstructionSizeMin = 2;
 
-        using Instructions = InstructionArray<
+        constexpr static auto Registers = generateRegisterNames();
+        constexpr static auto Flags = RegisterTable<4> { "N", "Z", "C", "V" };
+
+        using Instructions = OrderBySpecificity<InstructionArray<
                 InstrADCRegister,
                 InstrADDImmediateT1,
                 InstrADDImmediateT2,
@@ -1353,8 +1364,10 @@ namespace dc::disasm::arm::v7::thumb {
                 InstrWFE,
                 InstrWFI,
                 InstrYIELD
-        >;
+        >>;
     };
 
 
-}
\ No newline at end of file
+}
+
+DC_EXTERN_ARCHITECTURE(dc::disasm::arm::v7::thumb::Architecture);
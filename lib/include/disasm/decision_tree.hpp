@@ -0,0 +1,223 @@
+#pragma once
+
+#include <dc.hpp>
+#include <helpers/type_array.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dc::disasm {
+
+    /*
+     * Decoder for fixed width instruction sets that walks a decision tree synthesized from the BitPattern mask and
+     * compare values. Every inner node switches on the field of up to MaxFieldWidth adjacent bits that splits the
+     * remaining candidates most evenly, leaves hold the few candidates that are left over, in InstructionArray order.
+     * Switching on whole fields instead of single bits keeps the tree only a few levels deep, which matters as every
+     * level is a load depending on the previous one.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    class DecisionTreeDecoder {
+    public:
+        constexpr static size_t NotFound = T::Size;
+
+        [[nodiscard]]
+        static size_t find(std::span<const u8> bytes) {
+            if (bytes.size() < InstructionSize)
+                return NotFound;
+
+            const u32 word = T::template Get<0>::Pattern::loadWord(bytes);
+
+            const auto *node = &Tree.nodes[0];
+            while (!node->isLeaf())
+                node = &Tree.nodes[Tree.children[node->begin + ((word >> node->shift) & node->mask)]];
+
+            for (u32 i = node->begin; i < node->end; i++) {
+                const auto &candidate = Tree.candidates[i];
+                if ((word & candidate.mask) == candidate.compareValue)
+                    return candidate.index;
+            }
+
+            return NotFound;
+        }
+
+    private:
+        constexpr static u8 MaxFieldWidth = 4;
+
+        struct WordPattern {
+            u32 mask, compareValue;
+        };
+
+        /* Leaves hold the candidates' mask and compare values themselves so testing them needs no further lookup */
+        struct Candidate {
+            u32 mask, compareValue;
+            u16 index;
+        };
+
+        /*
+         * Inner nodes select their child from the children table at begin + the value of their field.
+         * Leaves test the candidates from begin to end.
+         */
+        struct Node {
+            constexpr static u8 Leaf = 0xFF;
+
+            u8 shift, mask;
+            u16 begin, end;
+
+            [[nodiscard]] constexpr bool isLeaf() const { return this->shift == Leaf; }
+        };
+
+        template<typename ... Instrs>
+        consteval static auto getWordPatterns(const hlp::TypeArray<Instrs...> &) {
+            return std::array<WordPattern, T::Size> {
+                WordPattern { Instrs::Pattern::getBitMaskWord(), Instrs::Pattern::getBitCompareValueWord() }...
+            };
+        }
+
+        template<typename ... Instrs>
+        consteval static bool isFixedWidth(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getByteCount() == T::template Get<0>::Pattern::getByteCount()) && ...);
+        }
+
+        template<typename ... Instrs>
+        consteval static bool isSameEndian(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getEndian() == T::template Get<0>::Pattern::getEndian()) && ...);
+        }
+
+        constexpr static size_t InstructionSize = T::template Get<0>::Pattern::getByteCount();
+        constexpr static auto Patterns = getWordPatterns(T{ });
+
+        struct TreeBuilder {
+            std::vector<Node> nodes;
+            std::vector<u16> children;
+            std::vector<u16> candidates;
+
+            /* Candidate lists nodes have already been built for. Different field values often leave the same candidates. */
+            std::vector<std::vector<u16>> builtIndices;
+
+            /* Whether a pattern can match a word whose field starting at shift has the given value */
+            constexpr static bool isCompatible(const WordPattern &pattern, u8 shift, u32 mask, u32 value) {
+                return (((pattern.compareValue >> shift) ^ value) & (pattern.mask >> shift) & mask) == 0;
+            }
+
+            constexpr u16 build(const std::vector<u16> &indices) {
+                for (size_t i = 0; i < this->builtIndices.size(); i++) {
+                    if (this->builtIndices[i] == indices)
+                        return u16(i);
+                }
+
+                const auto nodeIndex = u16(this->nodes.size());
+                this->nodes.push_back({ });
+                this->builtIndices.push_back(indices);
+
+                const auto count = indices.size();
+
+                // Pick the field leaving the fewest candidates in its largest branch, then the one duplicating the fewest candidates
+                u8 bestShift = Node::Leaf, bestWidth = 0;
+                size_t bestLargest = count, bestTotal = 0;
+                for (u8 width = 1; width <= MaxFieldWidth && count > 1; width++) {
+                    for (u8 shift = 0; shift + width <= InstructionSize * 8; shift++) {
+                        const u32 mask = (1U << width) - 1;
+
+                        size_t largest = 0, total = 0;
+                        for (u32 value = 0; value <= mask; value++) {
+                            const auto matching = size_t(std::count_if(indices.begin(), indices.end(), [&](u16 index) {
+                                return isCompatible(Patterns[index], shift, mask, value);
+                            }));
+
+                            largest = std::max(largest, matching);
+                            total += matching;
+                        }
+
+                        if (largest < bestLargest || (largest == bestLargest && bestShift != Node::Leaf && total < bestTotal)) {
+                            bestShift = shift;
+                            bestWidth = width;
+                            bestLargest = largest;
+                            bestTotal = total;
+                        }
+                    }
+                }
+
+                if (bestShift == Node::Leaf) {
+                    const auto begin = u16(this->candidates.size());
+                    for (auto index : indices)
+                        this->candidates.push_back(index);
+
+                    this->nodes[nodeIndex] = { Node::Leaf, 0, begin, u16(this->candidates.size()) };
+                } else {
+                    const u32 mask = (1U << bestWidth) - 1;
+
+                    std::vector<u16> children;
+                    for (u32 value = 0; value <= mask; value++) {
+                        std::vector<u16> matching;
+                        for (auto index : indices) {
+                            if (isCompatible(Patterns[index], bestShift, mask, value))
+                                matching.push_back(index);
+                        }
+
+                        children.push_back(this->build(matching));
+                    }
+
+                    const auto begin = u16(this->children.size());
+                    this->children.insert(this->children.end(), children.begin(), children.end());
+                    this->nodes[nodeIndex] = { bestShift, u8(mask), begin, u16(this->children.size()) };
+                }
+
+                return nodeIndex;
+            }
+
+            constexpr static TreeBuilder create() {
+                TreeBuilder builder;
+
+                std::vector<u16> indices;
+                for (u16 index = 0; index < T::Size; index++)
+                    indices.push_back(index);
+
+                builder.build(indices);
+
+                return builder;
+            }
+        };
+
+        struct TreeSize {
+            size_t nodeCount, childCount, candidateCount;
+        };
+
+        /* The tree is built once to size the tables and once more to fill them, as its vectors can't outlive constant evaluation */
+        consteval static TreeSize getTreeSize() {
+            const auto builder = TreeBuilder::create();
+            return { builder.nodes.size(), builder.children.size(), builder.candidates.size() };
+        }
+
+        consteval static auto generateTree() {
+            constexpr auto Size = getTreeSize();
+
+            struct {
+                std::array<Node, Size.nodeCount> nodes;
+                std::array<u16, Size.childCount> children;
+                std::array<Candidate, Size.candidateCount> candidates;
+            } result = { };
+
+            auto builder = TreeBuilder::create();
+            std::copy(builder.nodes.begin(), builder.nodes.end(), result.nodes.begin());
+            std::copy(builder.children.begin(), builder.children.end(), result.children.begin());
+            std::transform(builder.candidates.begin(), builder.candidates.end(), result.candidates.begin(), [](u16 index) {
+                return Candidate { Patterns[index].mask, Patterns[index].compareValue, index };
+            });
+
+            return result;
+        }
+
+        static_assert(isFixedWidth(T{ }), "Decision tree decoding requires all instructions to have the same size");
+        static_assert(isSameEndian(T{ }), "Decision tree decoding requires all instructions to have the same endianness");
+        static_assert(InstructionSize <= sizeof(u32), "Decision tree decoding only supports instructions of up to four bytes");
+        static_assert(T::Size <= std::numeric_limits<u16>::max(), "Too many instructions for decision tree");
+
+        constexpr static auto Tree = generateTree();
+    };
+
+}
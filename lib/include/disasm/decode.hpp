@@ -0,0 +1,234 @@
+#pragma once
+
+#include <disasm/architecture.hpp>
+#include <disasm/instruction.hpp>
+#include <disasm/decoder.hpp>
+#include <disasm/opcode_table.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace dc::disasm {
+
+    /*
+     * Compact record of a single decoded instruction. Instructions are pattern matched exactly once
+     * and both the disassembler and the decompiler work off these records afterwards.
+     * Bytes that don't belong to any known instruction are stored as records with an invalid id.
+     */
+    template<ArchitectureType T>
+    struct DecodedInstruction {
+    private:
+        template<typename ... Instrs>
+        consteval static size_t getMaxFieldCount(const hlp::TypeArray<Instrs...> &) {
+            return std::max({ size_t(0), Instrs::Pattern::getPlaceholderCount()... });
+        }
+
+    public:
+        constexpr static u16 InvalidId = T::Instructions::Size;
+        constexpr static size_t MaxFieldCount = getMaxFieldCount(typename T::Instructions{ });
+
+        /* Maximum number of consecutive undecodable bytes merged into a single data record */
+        constexpr static size_t MaxDataRunLength = 16;
+
+        /*
+         * Runs of at least MinFillLength identical undecodable bytes get a data record of their own, which is written out as a
+         * single fill directive instead of a list of bytes. Such records hold as many whole units of InstructionSizeMin bytes as fit in their length.
+         */
+        constexpr static size_t MinFillLength = 4;
+        constexpr static size_t MaxFillLength = std::numeric_limits<u8>::max() / T::InstructionSizeMin * T::InstructionSizeMin;
+
+        u64 offset;
+        u8 length;
+        u16 id;
+        Category category;
+
+        /* Placeholder values in the order the placeholders first appear in the instruction's pattern */
+        std::array<u32, MaxFieldCount> fields;
+
+        [[nodiscard]] constexpr bool isValid() const { return this->id != InvalidId; }
+    };
+
+    /*
+     * Structure-of-arrays form of a decoded byte span. Every array holds one entry per instruction
+     * so analysis passes can scan the individual columns without touching unrelated data.
+     */
+    template<ArchitectureType T>
+    struct DecodedImage {
+        constexpr static u16 InvalidId = DecodedInstruction<T>::InvalidId;
+        constexpr static size_t FieldStride = DecodedInstruction<T>::MaxFieldCount;
+
+        std::vector<u64> offsets;
+        std::vector<u8> lengths;
+        std::vector<u16> ids;
+
+        /* Placeholder values of all instructions, FieldStride entries per instruction */
+        std::vector<u32> fields;
+
+        [[nodiscard]] size_t size() const { return this->ids.size(); }
+
+        [[nodiscard]] std::span<const u32> getFields(size_t index) const {
+            return std::span(this->fields).subspan(index * FieldStride, FieldStride);
+        }
+
+        void reserve(size_t count) {
+            this->offsets.reserve(count);
+            this->lengths.reserve(count);
+            this->ids.reserve(count);
+            this->fields.reserve(count * FieldStride);
+        }
+
+        void push_back(const DecodedInstruction<T> &instruction) {
+            this->offsets.push_back(instruction.offset);
+            this->lengths.push_back(instruction.length);
+            this->ids.push_back(instruction.id);
+            this->fields.insert(this->fields.end(), instruction.fields.begin(), instruction.fields.end());
+        }
+    };
+
+    namespace {
+
+        template<ArchitectureType T, typename Instr, size_t Index>
+        DecodedInstruction<T> decodeInstruction(u64 offset, std::span<const u8> bytes) {
+            constexpr auto Placeholders = Instr::Pattern::getPlaceholders();
+
+            DecodedInstruction<T> result = { offset, u8(Instr::Pattern::getByteCount()), Index, Instr::Category, { } };
+
+            [&]<size_t ... Is>(std::index_sequence<Is...>) {
+                static_assert(((Instr::Pattern::template getPlaceholderBitCount<Placeholders[Is]>() <= sizeof(u32) * 8) && ...),
+                              "Placeholder too wide to be stored in a decoded instruction record");
+
+                ((result.fields[Is] = u32(Instr::Pattern::template getPlaceholderValue<Placeholders[Is]>(bytes))), ...);
+            }(std::make_index_sequence<Placeholders.size()>());
+
+            return result;
+        }
+
+        template<ArchitectureType T, typename ... Instrs, size_t ... Is>
+        constexpr auto getInstructionDecoders(const hlp::TypeArray<Instrs...> &, std::index_sequence<Is...>) {
+            return std::array { &decodeInstruction<T, Instrs, Is>... };
+        }
+
+        template<typename Decoder>
+        bool isUndecodable(std::span<const u8> bytes) {
+            if constexpr (requires { { Decoder::hasCandidates(bytes) } -> std::same_as<bool>; }) {
+                if (!Decoder::hasCandidates(bytes))
+                    return true;
+            }
+
+            return Decoder::find(bytes) == Decoder::NotFound;
+        }
+
+        /* Length of the run of undecodable units starting at offset that consist of nothing but the byte at offset, up to maxLength bytes */
+        template<ArchitectureType T, typename Decoder>
+        size_t getFillRunLength(u64 offset, std::span<const u8> bytes, size_t maxLength) {
+            const auto value = bytes[offset];
+
+            size_t length = 0;
+            while (offset + length < bytes.size()) {
+                const auto unitBytes = bytes.subspan(offset + length);
+                const auto unitLength = std::min<size_t>(T::InstructionSizeMin, unitBytes.size());
+
+                if (length + unitLength > maxLength)
+                    break;
+                if (std::any_of(unitBytes.begin(), unitBytes.begin() + unitLength, [value](u8 byte) { return byte != value; }))
+                    break;
+                if (!isUndecodable<Decoder>(unitBytes))
+                    break;
+
+                length += unitLength;
+            }
+
+            return length;
+        }
+
+    }
+
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    DecodedInstruction<T> decodeInstruction(u64 offset, std::span<const u8> bytes) {
+        using Instructions = typename T::Instructions;
+        static_assert(DecoderType<Decoder<Instructions>>);
+
+        constexpr static auto InstructionDecoders = getInstructionDecoders<T>(Instructions{ }, std::make_index_sequence<Instructions::Size>());
+
+        auto instructionBytes = bytes.subspan(offset);
+        if (auto index = Decoder<Instructions>::find(instructionBytes); index != Decoder<Instructions>::NotFound)
+            return InstructionDecoders[index](offset, instructionBytes);
+        else
+            return { offset, u8(std::min<size_t>(T::InstructionSizeMin, instructionBytes.size())), DecodedInstruction<T>::InvalidId, Category::Other, { } };
+    }
+
+    /*
+     * Decodes the instruction at the given offset like decodeInstruction does. If there's no valid instruction,
+     * the following undecodable bytes are merged into the same data record so data regions don't produce
+     * a separate record for every single byte. Runs of identical bytes, like padding, end up in records of their own.
+     */
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    DecodedInstruction<T> decodeNext(u64 offset, std::span<const u8> bytes) {
+        using Instructions = typename T::Instructions;
+        using Record = DecodedInstruction<T>;
+
+        auto instruction = decodeInstruction<T, Decoder>(offset, bytes);
+        if (instruction.isValid())
+            return instruction;
+
+        if (const auto fillLength = getFillRunLength<T, Decoder<Instructions>>(offset, bytes, Record::MaxFillLength); fillLength >= Record::MinFillLength) {
+            instruction.length = u8(fillLength);
+            return instruction;
+        }
+
+        while (true) {
+            const auto nextOffset = offset + instruction.length;
+            if (nextOffset >= bytes.size())
+                break;
+
+            const auto nextBytes = bytes.subspan(nextOffset);
+            const auto nextLength = std::min<size_t>(T::InstructionSizeMin, nextBytes.size());
+            if (instruction.length + nextLength > Record::MaxDataRunLength)
+                break;
+            if (!isUndecodable<Decoder<Instructions>>(nextBytes))
+                break;
+            if (getFillRunLength<T, Decoder<Instructions>>(nextOffset, bytes, Record::MinFillLength) >= Record::MinFillLength)
+                break;
+
+            instruction.length += nextLength;
+        }
+
+        return instruction;
+    }
+
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    std::vector<DecodedInstruction<T>> decode(std::span<const u8> bytes) {
+        std::vector<DecodedInstruction<T>> instructions;
+        instructions.reserve(bytes.size() / T::InstructionSizeMin);
+
+        u64 offset = 0x00;
+
+        while (offset < bytes.size()) {
+            const auto &instruction = instructions.emplace_back(decodeNext<T, Decoder>(offset, bytes));
+            offset += instruction.length;
+        }
+
+        return instructions;
+    }
+
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    DecodedImage<T> decodeImage(std::span<const u8> bytes) {
+        DecodedImage<T> image;
+        image.reserve(bytes.size() / T::InstructionSizeMin);
+
+        u64 offset = 0x00;
+        while (offset < bytes.size()) {
+            const auto instruction = decodeNext<T, Decoder>(offset, bytes);
+            image.push_back(instruction);
+
+            offset += instruction.length;
+        }
+
+        return image;
+    }
+
+}
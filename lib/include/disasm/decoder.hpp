@@ -0,0 +1,41 @@
+#pragma once
+
+#include <dc.hpp>
+#include <helpers/type_array.hpp>
+
+#include <concepts>
+#include <span>
+#include <utility>
+
+namespace dc::disasm {
+
+    /*
+     * A decoder finds the index of the instruction matching the start of a byte span
+     * within an InstructionArray, or returns NotFound if none of them match.
+     */
+    template<typename T>
+    concept DecoderType = requires(std::span<const u8> bytes) {
+        { T::NotFound } -> std::convertible_to<size_t>;
+        { T::find(bytes) } -> std::same_as<size_t>;
+    };
+
+    /*
+     * Reference decoder testing every pattern one after another in InstructionArray order
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    class LinearDecoder {
+    public:
+        constexpr static size_t NotFound = T::Size;
+
+        [[nodiscard]]
+        static size_t find(std::span<const u8> bytes) {
+            return [&]<typename ... Instrs>(const hlp::TypeArray<Instrs...> &) {
+                size_t result = 0;
+                (void)((Instrs::Pattern::matches(bytes) || (result++, false)) || ...);
+
+                return result;
+            }(T{ });
+        }
+    };
+
+}
@@ -2,51 +2,116 @@
 
 #include <disasm/architecture.hpp>
 #include <disasm/instruction.hpp>
+#include <disasm/decode.hpp>
+#include <algorithm>
+#include <iterator>
 #include <span>
+#include <string>
+#include <vector>
+
+#include <fmt/ranges.h>
 
 namespace dc::disasm {
 
     namespace {
 
-        template<std::derived_from<dc::hlp::TypeArrayBase> T, size_t Index>
-        std::pair<size_t, std::string> disassemble(u64 offset, std::span<const u8> bytes) {
-            using Instr = typename T::template Get<Index>;
+        template<InstructionType Instr>
+        void disassemble(fmt::appender out, u64 offset, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{} "), Instr::Mnemonic);
+            Instr::disassemble(out, offset, bytes);
+        }
+
+        template<typename ... Instrs>
+        constexpr auto getDisassemblers(const hlp::TypeArray<Instrs...> &) {
+            return std::array { &disassemble<Instrs>... };
+        }
+
+    }
+
+    /*
+     * Stack buffer large enough to hold the text of any single instruction without touching the heap
+     */
+    using InstructionBuffer = fmt::basic_memory_buffer<char, 64>;
+
+    /*
+     * Appends the disassembly of a single decoded instruction to a caller provided buffer.
+     * Reusing the same buffer for many instructions avoids allocating a new string for each of them.
+     */
+    template<dc::disasm::ArchitectureType T, size_t Size>
+    void disassembleInstruction(fmt::basic_memory_buffer<char, Size> &buffer, const DecodedInstruction<T> &instruction, std::span<const u8> bytes) {
+        using Instructions = typename T::Instructions;
+        constexpr static auto Disassemblers = getDisassemblers(Instructions{ });
 
-            if (Instr::Pattern::matches(bytes))
-                return { Instr::Pattern::getByteCount(), fmt::format("{} {}", Instr::Mnemonic, Instr::disassemble(offset, bytes)) };
-            else if constexpr (Index < (T::Size - 1))
-                return disassemble<T, Index + 1>(offset, bytes);
-            else
-                return { 0, "" };
+        if (instruction.isValid()) {
+            Disassemblers[instruction.id](fmt::appender(buffer), instruction.offset, bytes.subspan(instruction.offset));
+            return;
         }
 
+        // Runs of the same byte are written with their count instead of listing every byte
+        const auto data = bytes.subspan(instruction.offset, instruction.length);
+        if (data.size() >= DecodedInstruction<T>::MinFillLength && std::all_of(data.begin(), data.end(), [&](u8 byte) { return byte == data.front(); }))
+            fmt::format_to(fmt::appender(buffer), FMT_COMPILE(".fill {}, 1, 0x{:02X}"), data.size(), data.front());
+        else
+            fmt::format_to(fmt::appender(buffer), FMT_COMPILE(".byte 0x{:02X}"), fmt::join(data, ", 0x"));
     }
 
+    /*
+     * Writes the disassembly of a single decoded instruction to any output iterator, formatting it on the stack first
+     */
+    template<dc::disasm::ArchitectureType T, std::output_iterator<char> OutputIt>
+    OutputIt disassembleInstruction(OutputIt out, const DecodedInstruction<T> &instruction, std::span<const u8> bytes) {
+        InstructionBuffer buffer;
+        disassembleInstruction<T>(buffer, instruction, bytes);
+
+        return std::copy(buffer.begin(), buffer.end(), out);
+    }
 
     template<dc::disasm::ArchitectureType T>
-    auto disassemble(std::span<const u8> bytes) {
-        std::vector<std::string> disassembly;
-        ssize_t offset = 0x00;
+    std::string disassembleInstruction(const DecodedInstruction<T> &instruction, std::span<const u8> bytes) {
+        InstructionBuffer buffer;
+        disassembleInstruction<T>(buffer, instruction, bytes);
 
-        while (offset < bytes.size()) {
-            auto begin = bytes.begin() + offset;
+        return fmt::to_string(buffer);
+    }
 
-            auto [size, disas] = disassemble<typename T::Instructions, 0>(offset, std::span { begin, bytes.end() });
-            if (size < T::InstructionSizeMin) {
+    /*
+     * Appends the disassembly of all instructions to a buffer, one instruction per line
+     */
+    template<dc::disasm::ArchitectureType T>
+    void disassemble(fmt::memory_buffer &buffer, std::span<const u8> bytes, std::span<const DecodedInstruction<T>> instructions) {
+        for (const auto &instruction : instructions) {
+            disassembleInstruction<T>(buffer, instruction, bytes);
+            buffer.push_back('\n');
+        }
+    }
 
-                for (u32 i = 0; i < T::InstructionSizeMin; i++) {
-                    disassembly.push_back(fmt::format(".byte 0x{:02X}", *(begin + i)));
-                    offset += 1;
-                }
+    template<dc::disasm::ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    void disassemble(fmt::memory_buffer &buffer, std::span<const u8> bytes) {
+        const auto instructions = decode<T, Decoder>(bytes);
 
-            }
-            else {
-                disassembly.push_back(disas);
-                offset += size;
-            }
+        disassemble<T>(buffer, bytes, std::span<const DecodedInstruction<T>>(instructions));
+    }
+
+    template<dc::disasm::ArchitectureType T>
+    std::vector<std::string> disassemble(std::span<const u8> bytes, std::span<const DecodedInstruction<T>> instructions) {
+        std::vector<std::string> disassembly;
+        disassembly.reserve(instructions.size());
+
+        InstructionBuffer buffer;
+        for (const auto &instruction : instructions) {
+            buffer.clear();
+            disassembleInstruction<T>(buffer, instruction, bytes);
+            disassembly.emplace_back(buffer.data(), buffer.size());
         }
 
         return disassembly;
     }
 
-}
\ No newline at end of file
+    template<dc::disasm::ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    std::vector<std::string> disassemble(std::span<const u8> bytes) {
+        const auto instructions = decode<T, Decoder>(bytes);
+
+        return disassemble<T>(bytes, instructions);
+    }
+
+}
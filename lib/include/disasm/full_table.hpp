@@ -0,0 +1,79 @@
+#pragma once
+
+#include <dc.hpp>
+#include <disasm/decoder.hpp>
+#include <helpers/type_array.hpp>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace dc::disasm {
+
+    /*
+     * Decoder for instruction sets of up to 16 bit fixed width instructions using a table holding the index of the
+     * matching instruction for every possible instruction word. Decoding is a single load per instruction.
+     * The table is generated from the InstructionArray's match order on first use, as generating all 64K entries
+     * at compile time would take considerably longer than doing so at runtime.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    class FullTableDecoder {
+    public:
+        constexpr static size_t NotFound = T::Size;
+
+        [[nodiscard]]
+        static size_t find(std::span<const u8> bytes) {
+            if (bytes.size() < InstructionSize)
+                return NotFound;
+
+            return getTable()[T::template Get<0>::Pattern::loadWord(bytes)];
+        }
+
+    private:
+        template<typename ... Instrs>
+        consteval static bool isFixedWidth(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getByteCount() == T::template Get<0>::Pattern::getByteCount()) && ...);
+        }
+
+        template<typename ... Instrs>
+        consteval static bool isSameEndian(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getEndian() == T::template Get<0>::Pattern::getEndian()) && ...);
+        }
+
+        constexpr static size_t InstructionSize = T::template Get<0>::Pattern::getByteCount();
+        constexpr static size_t EntryCount = size_t(1) << (InstructionSize * 8);
+
+        using Table = std::array<u16, EntryCount>;
+
+        static const Table& getTable() {
+            static const auto table = [] {
+                auto result = std::make_unique<Table>();
+
+                for (size_t word = 0; word < EntryCount; word++) {
+                    // Lay out the word in memory the way the patterns expect it so loadWord() returns it again
+                    std::array<u8, InstructionSize> bytes = { };
+                    for (size_t i = 0; i < InstructionSize; i++) {
+                        const auto shift = (T::template Get<0>::Pattern::getEndian() == std::endian::little ? i : (InstructionSize - 1 - i)) * 8;
+                        bytes[i] = u8(word >> shift);
+                    }
+
+                    (*result)[word] = u16(LinearDecoder<T>::find(bytes));
+                }
+
+                return result;
+            }();
+
+            return *table;
+        }
+
+        static_assert(isFixedWidth(T{ }), "Full table decoding requires all instructions to have the same size");
+        static_assert(isSameEndian(T{ }), "Full table decoding requires all instructions to have the same endianness");
+        static_assert(InstructionSize <= sizeof(u16), "Full table decoding only supports instructions of up to two bytes");
+        static_assert(T::Size <= std::numeric_limits<u16>::max(), "Too many instructions for full table");
+    };
+
+}
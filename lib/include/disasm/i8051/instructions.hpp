@@ -5,6 +5,9 @@
 #include <tuple>
 #include <string>
 #include <disasm/instruction.hpp>
+#include <disasm/pattern_order.hpp>
+#include <disasm/registers.hpp>
+#include <decomp/instantiate.hpp>
 
 namespace dc::disasm::i8051 {
 
@@ -15,17 +18,168 @@ namespace dc::disasm::i8051 {
 
     template<hlp::StaticString MnemonicValue, hlp::StaticString PatternValue, Category Category>
     struct Instruction8051 : public Instruction8051Base<MnemonicValue, PatternValue, Category> {
+        using Parent = Instruction8051Base<MnemonicValue, PatternValue, Category>;
+
+        /* Relative jump offsets are signed and relative to the address of the following instruction */
+        template<typename Offset>
+        constexpr static u16 getRelativeTarget(u64 address, std::span<const u8> bytes) {
+            return u16(address + Parent::Pattern::getByteCount() + i8(Offset::get(bytes)));
+        }
+
         constexpr static std::string disassemble(u64 address, std::span<const u8> bytes) {
             return asVector(create<ASTNodeAssembly>(fmt::format("{} {}", MnemonicValue, disassemble(address, bytes))));
         }
     };
 
-    struct InstrNop : public Instruction8051<"nop", "0000'0000", Category::Other> {
-        constexpr static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "";
+    consteval RegisterName generateRegisterName(u8 reg) {
+        switch (reg) {
+            case 0x00: return "R0";
+            case 0x01: return "R1";
+            case 0x02: return "R2";
+            case 0x03: return "R3";
+            case 0x04: return "R4";
+            case 0x05: return "R5";
+            case 0x06: return "R6";
+            case 0x07: return "R7";
+            case 0x80: return "P0";
+            case 0x81: return "SP";
+            case 0x82: return "DPL";
+            case 0x83: return "DPH";
+            case 0x87: return "PCON";
+            case 0x88: return "TCON";
+            case 0x89: return "TMOD";
+            case 0x8A: return "TL0";
+            case 0x8B: return "TL1";
+            case 0x8C: return "TH0";
+            case 0x8D: return "TH1";
+            case 0x90: return "P1";
+            case 0x98: return "SCON";
+            case 0x99: return "SBUF";
+            case 0xA0: return "P2";
+            case 0xA8: return "IE";
+            case 0xB0: return "P3";
+            case 0xB8: return "IP";
+            case 0xD0: return "PSW";
+            case 0xE0: return "ACC";
+            case 0xF0: return "B";
+            default: return RegisterName("SFR_").appendHex(reg, 2);
+        }
+    }
+
+    consteval RegisterName generateBitName(u8 index) {
+        if (index <= 0x7F)
+            return RegisterName("MEM.").appendDecimal(index);
+        else if (index >= 0x80 && index <= 0x87)
+            return RegisterName("P0.").appendDecimal(index - 0x80);
+        else if (index >= 0x90 && index <= 0x9F)
+            return RegisterName("P1.").appendDecimal(index - 0x90);
+        else if (index >= 0xA0 && index <= 0xA7)
+            return RegisterName("P2.").appendDecimal(index - 0xA0);
+        else if (index >= 0xB0 && index <= 0xB7)
+            return RegisterName("P3.").appendDecimal(index - 0xB0);
+        else if (index >= 0xE0 && index <= 0xE7)
+            return RegisterName("A.").appendDecimal(index - 0xE0);
+        else if (index >= 0xF0 && index <= 0xF7)
+            return RegisterName("B.").appendDecimal(index - 0xF0);
+        else {
+            switch (index) {
+                // TCON
+                case 0x88: return "IT0";
+                case 0x89: return "IE0";
+                case 0x8A: return "IT1";
+                case 0x8B: return "IE1";
+                case 0x8C: return "TR0";
+                case 0x8D: return "TF0";
+                case 0x8E: return "TR1";
+                case 0x8F: return "TF1";
+
+                // SCON
+                case 0x98: return "RI";
+                case 0x99: return "TI";
+                case 0x9A: return "RB8";
+                case 0x9B: return "TB8";
+                case 0x9C: return "REN";
+                case 0x9D: return "SM2";
+                case 0x9E: return "SM1";
+                case 0x9F: return "SM0";
+
+                // IE
+                case 0xA8: return "EX0";
+                case 0xA9: return "ET0";
+                case 0xAA: return "EX1";
+                case 0xAB: return "ET1";
+                case 0xAC: return "ES";
+                case 0xAF: return "EA";
+
+                // IP
+                case 0xB8: return "PX0";
+                case 0xB9: return "PT0";
+                case 0xBA: return "PX1";
+                case 0xBB: return "PT1";
+                case 0xBC: return "PS";
+
+                // PSW
+                case 0xD0: return "P";
+                case 0xD1: return "1";
+                case 0xD2: return "OV";
+                case 0xD3: return "RS0";
+                case 0xD4: return "RS1";
+                case 0xD5: return "F0";
+                case 0xD6: return "AC";
+                case 0xD7: return "CY";
+
+                default: return RegisterName("0x").appendHex(index, 2);
+            }
         }
+    }
+
+    /*
+     * Registers are identified by their direct address, so R0 - R7 are the registers of the first bank.
+     * Flags are identified by their bit address. Registers and flags without an address follow after those.
+     */
+    constexpr RegisterId RegisterA      = 0x100;
+    constexpr RegisterId RegisterDPTR   = 0x101;
+
+    constexpr RegisterId FlagC          = 0x100;
+    constexpr RegisterId FlagPSWC       = 0x101;
+
+    consteval auto generateRegisterNames() {
+        RegisterTable<0x102> result;
 
-        constexpr static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        for (u32 address = 0x00; address <= 0xFF; address++)
+            result[address] = generateRegisterName(address);
+        result[RegisterA]       = "A";
+        result[RegisterDPTR]    = "DPTR";
+
+        return result;
+    }
+
+    consteval auto generateFlagNames() {
+        RegisterTable<0x102> result;
+
+        for (u32 address = 0x00; address <= 0xFF; address++)
+            result[address] = generateBitName(address);
+        result[FlagC]       = "C";
+        result[FlagPSWC]    = "PSW.C";
+
+        return result;
+    }
+
+    constexpr inline auto RegisterNames = generateRegisterNames();
+    constexpr inline auto FlagNames = generateFlagNames();
+
+    inline std::string_view getRegisterName(u8 reg) {
+        return RegisterNames[reg].get();
+    }
+
+    inline std::string_view getBitName(u8 index) {
+        return FlagNames[index].get();
+    }
+
+    struct InstrNop : public Instruction8051<"nop", "0000'0000", Category::Other> {
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
+
+        constexpr static NodeList decompile(u64, std::span<const u8>) {
             return { };
         }
     };
@@ -33,11 +187,11 @@ namespace dc::disasm::i8051 {
     struct InstrAJmp : public Instruction8051<"ajmp", "ppp0'0001'aaaa'aaaa", Category::UnconditionalJump> {
         using a = Placeholder<'a'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", a::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), a::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                 create<ASTNodeJump>(create<ASTNodeIntegerLiteral>(a::get(bytes)))
             );
@@ -47,11 +201,11 @@ namespace dc::disasm::i8051 {
     struct InstrLJmp : public Instruction8051<"ljmp", "0000'0010'aaaa'aaaa'aaaa'aaaa", Category::UnconditionalJump> {
         using a = Placeholder<'a'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", a::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), a::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeJump>(create<ASTNodeIntegerLiteral>(a::get(bytes)))
             );
@@ -61,31 +215,31 @@ namespace dc::disasm::i8051 {
     struct InstrSJmp : public Instruction8051<"sjmp", "1000'0000'aaaa'aaaa", Category::UnconditionalJump> {
         using a = Placeholder<'a'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", address + a::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), getRelativeTarget<a>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
-                    create<ASTNodeJump>(create<ASTNodeIntegerLiteral>(address + a::get(bytes)))
+                    create<ASTNodeJump>(create<ASTNodeIntegerLiteral>(getRelativeTarget<a>(address, bytes)))
             );
         }
     };
 
     struct InstrRR : public Instruction8051<"rr", "0000'0011", Category::Arithmetic> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "A";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeRegister>("A"),
+                                    create<ASTNodeRegister>(RegisterA),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::RotateRight
                             ),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -94,57 +248,57 @@ namespace dc::disasm::i8051 {
     struct InstrIncR : public Instruction8051<"inc", "0000'1nnn", Category::RegisterAccess> {
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("R{}", n::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}"), n::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::Add
                             ),
-                            create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes)))
                     )
             );
         }
     };
 
     struct InstrIncDPTR : public Instruction8051<"inc", "1010'0011", Category::RegisterAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("DPTR");
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("DPTR"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeRegister>("DPTR"),
+                                    create<ASTNodeRegister>(RegisterDPTR),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::Add
                             ),
-                            create<ASTNodeRegister>("DPTR")
+                            create<ASTNodeRegister>(RegisterDPTR)
                     )
             );
         }
     };
 
     struct InstrIncA : public Instruction8051<"inc", "0000'0100", Category::RegisterAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "A";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeRegister>("A"),
+                                    create<ASTNodeRegister>(RegisterA),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::Add
                             ),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -152,11 +306,11 @@ namespace dc::disasm::i8051 {
 
     struct InstrIncDirect : public Instruction8051<"inc", "0000'0101'dddd'dddd", Category::MemoryAccess> {
         using d = Placeholder<'d'>;
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", d::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), d::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
@@ -172,19 +326,19 @@ namespace dc::disasm::i8051 {
 
     struct InstrIncIndirect : public Instruction8051<"inc", "0000'011i", Category::MemoryAccess> {
         using i = Placeholder<'i'>;
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("@R{}", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(fmt::format("R{}", i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::Add
                             ),
-                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(fmt::format("R{}", i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference)
+                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference)
                     )
             );
         }
@@ -193,21 +347,21 @@ namespace dc::disasm::i8051 {
     struct InstrJC : public Instruction8051<"jc", "0100'0000'oooo'oooo", Category::ConditionalJump> {
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", address + o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeFlag>("PSW.C"),
+                                    create<ASTNodeFlag>(FlagPSWC),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::BoolEqual
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -218,21 +372,21 @@ namespace dc::disasm::i8051 {
     struct InstrJNC : public Instruction8051<"jnc", "0101'0000'oooo'oooo", Category::ConditionalJump> {
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", address + o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeFlag>("PSW.C"),
+                                    create<ASTNodeFlag>(FlagPSWC),
                                     create<ASTNodeIntegerLiteral>(0),
                                     ASTNodeBinaryArithmetic::Operator::BoolEqual
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -240,24 +394,24 @@ namespace dc::disasm::i8051 {
         }
     };
 
-    struct InstrJZ : public Instruction8051<"jz", "0111'0000'oooo'oooo", Category::ConditionalJump> {
+    struct InstrJZ : public Instruction8051<"jz", "0110'0000'oooo'oooo", Category::ConditionalJump> {
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", address + o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeRegister>("A"),
+                                    create<ASTNodeRegister>(RegisterA),
                                     create<ASTNodeIntegerLiteral>(0),
                                     ASTNodeBinaryArithmetic::Operator::BoolEqual
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -268,21 +422,21 @@ namespace dc::disasm::i8051 {
     struct InstrJNZ : public Instruction8051<"jnz", "0111'0000'oooo'oooo", Category::ConditionalJump> {
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", address + o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeRegister>("A"),
+                                    create<ASTNodeRegister>(RegisterA),
                                     create<ASTNodeIntegerLiteral>(0),
                                     ASTNodeBinaryArithmetic::Operator::BoolNotEqual
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -290,127 +444,25 @@ namespace dc::disasm::i8051 {
         }
     };
 
-    std::string getRegisterName(u8 reg) {
-        switch (reg) {
-            case 0x00: return "R0";
-            case 0x01: return "R1";
-            case 0x02: return "R2";
-            case 0x03: return "R3";
-            case 0x04: return "R4";
-            case 0x05: return "R5";
-            case 0x06: return "R6";
-            case 0x07: return "R7";
-            case 0x80: return "P0";
-            case 0x81: return "SP";
-            case 0x82: return "DPL";
-            case 0x83: return "DPH";
-            case 0x87: return "PCON";
-            case 0x88: return "TCON";
-            case 0x89: return "TMOD";
-            case 0x8A: return "TL0";
-            case 0x8B: return "TL1";
-            case 0x8C: return "TH0";
-            case 0x8D: return "TH1";
-            case 0x90: return "P1";
-            case 0x98: return "SCON";
-            case 0x99: return "SBUF";
-            case 0xA0: return "P2";
-            case 0xA8: return "IE";
-            case 0xB0: return "P3";
-            case 0xB8: return "IP";
-            case 0xD0: return "PSW";
-            case 0xE0: return "ACC";
-            case 0xF0: return "B";
-            default: return fmt::format("SFR_{:02X}", reg);
-        }
-    }
-
-    std::string getBitName(u8 index) {
-        if (index >= 0x00 && index <= 0x7F)
-            return fmt::format("MEM.{}", index);
-        else if (index >= 0x80 && index <= 0x87)
-            return fmt::format("P0.{}", index - 0x80);
-        else if (index >= 0x90 && index <= 0x9F)
-            return fmt::format("P1.{}", index - 0x90);
-        else if (index >= 0xA0 && index <= 0xA7)
-            return fmt::format("P2.{}", index - 0xA0);
-        else if (index >= 0xB0 && index <= 0xB7)
-            return fmt::format("P3.{}", index - 0xB0);
-        else if (index >= 0xE0 && index <= 0xE7)
-            return fmt::format("A.{}", index - 0xE0);
-        else if (index >= 0xF0 && index <= 0xF7)
-            return fmt::format("B.{}", index - 0xF0);
-        else {
-            switch (index) {
-                // TCON
-                case 0x88: return "IT0";
-                case 0x89: return "IE0";
-                case 0x8A: return "IT1";
-                case 0x8B: return "IE1";
-                case 0x8C: return "TR0";
-                case 0x8D: return "TF0";
-                case 0x8E: return "TR1";
-                case 0x8F: return "TF1";
-
-                // SCON
-                case 0x98: return "RI";
-                case 0x99: return "TI";
-                case 0x9A: return "RB8";
-                case 0x9B: return "TB8";
-                case 0x9C: return "REN";
-                case 0x9D: return "SM2";
-                case 0x9E: return "SM1";
-                case 0x9F: return "SM0";
-
-                // IE
-                case 0xA8: return "EX0";
-                case 0xA9: return "ET0";
-                case 0xAA: return "EX1";
-                case 0xAB: return "ET1";
-                case 0xAC: return "ES";
-                case 0xAF: return "EA";
-
-                // IP
-                case 0xB8: return "PX0";
-                case 0xB9: return "PT0";
-                case 0xBA: return "PX1";
-                case 0xBB: return "PT1";
-                case 0xBC: return "PS";
-
-                // PSW
-                case 0xD0: return "P";
-                case 0xD1: return "1";
-                case 0xD2: return "OV";
-                case 0xD3: return "RS0";
-                case 0xD4: return "RS1";
-                case 0xD5: return "F0";
-                case 0xD6: return "AC";
-                case 0xD7: return "CY";
-
-                default: return fmt::format("0x{:02X}", index);
-            }
-        }
-    }
-
     struct InstrJNB : public Instruction8051<"jnb", "0011'0000'bbbb'bbbb'oooo'oooo", Category::ConditionalJump> {
         using b = Placeholder<'b'>;
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, #0x{:02X}", getBitName(b::get(bytes)), o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02X}"), getBitName(b::get(bytes)), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeFlag>(getBitName(b::get(bytes))),
+                                    create<ASTNodeFlag>(RegisterId(b::get(bytes))),
                                     create<ASTNodeIntegerLiteral>(0),
                                     ASTNodeBinaryArithmetic::Operator::BoolEqual
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -422,21 +474,21 @@ namespace dc::disasm::i8051 {
         using b = Placeholder<'b'>;
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, #0x{:02X}", getBitName(b::get(bytes)), o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02X}"), getBitName(b::get(bytes)), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeFlag>(getBitName(b::get(bytes))),
+                                    create<ASTNodeFlag>(RegisterId(b::get(bytes))),
                                     create<ASTNodeIntegerLiteral>(0),
                                     ASTNodeBinaryArithmetic::Operator::BoolNotEqual
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -447,30 +499,30 @@ namespace dc::disasm::i8051 {
     struct InstrCLRBit : public Instruction8051<"clr", "1100'0010'bbbb'bbbb", Category::MemoryAccess> {
         using b = Placeholder<'b'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}", getBitName(b::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}"), getBitName(b::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(0),
-                            create<ASTNodeFlag>(getBitName(b::get(bytes)))
+                            create<ASTNodeFlag>(RegisterId(b::get(bytes)))
                     )
             );
         }
     };
 
     struct InstrSETBC : public Instruction8051<"set", "1101'0011", Category::RegisterAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "C";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("C"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(1),
-                            create<ASTNodeFlag>("C")
+                            create<ASTNodeFlag>(FlagC)
                     )
             );
         }
@@ -479,45 +531,45 @@ namespace dc::disasm::i8051 {
     struct InstrSETBBit : public Instruction8051<"set", "1101'0010'bbbb'bbbb", Category::MemoryAccess> {
         using b = Placeholder<'b'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}", getBitName(b::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}"), getBitName(b::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(1),
-                            create<ASTNodeFlag>(getBitName(b::get(bytes)))
+                            create<ASTNodeFlag>(RegisterId(b::get(bytes)))
                     )
             );
         }
     };
 
     struct InstrCLRC : public Instruction8051<"clr", "1100'0011", Category::RegisterAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "C";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("C"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(0),
-                            create<ASTNodeFlag>("C")
+                            create<ASTNodeFlag>(FlagC)
                     )
             );
         }
     };
 
     struct InstrCLRA : public Instruction8051<"clr", "1110'0100", Category::RegisterAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "A";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(0),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -527,16 +579,16 @@ namespace dc::disasm::i8051 {
         using n = Placeholder<'n'>;
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("@R{}, #0x{:02X}", n::get(bytes), i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}, #0x{:02X}"), n::get(bytes), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(i::get(bytes)),
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             )
                     )
@@ -547,16 +599,16 @@ namespace dc::disasm::i8051 {
     struct InstrMOVRegAddrA : public Instruction8051<"mov", "1111'011i", Category::MemoryAccess> {
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("@R{}, A", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}, A"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>("A"),
+                            create<ASTNodeRegister>(RegisterA),
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>(fmt::format("R{}", i::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(i::get(bytes))),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             )
                     )
@@ -568,16 +620,16 @@ namespace dc::disasm::i8051 {
         using i = Placeholder<'i'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("@R{}, {}", i::get(bytes), getRegisterName(d::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}, {}"), i::get(bytes), getRegisterName(d::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes))),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes))),
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>(getRegisterName(i::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(i::get(bytes))),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             )
                     )
@@ -588,15 +640,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVAImmediate : public Instruction8051<"mov", "0111'0100'iiii'iiii", Category::RegisterAccess> {
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("A, #0x{:02X}", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(i::get(bytes)),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -605,15 +657,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVARegAddr : public Instruction8051<"mov", "1110'011i", Category::RegisterAccess> {
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("A, @R{}", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(i::get(bytes)),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -622,15 +674,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVADirect : public Instruction8051<"mov", "1110'0101'dddd'dddd", Category::RegisterAccess> {
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("A, {}", getRegisterName(d::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes))),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -639,15 +691,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVAReg : public Instruction8051<"mov", "1110'1nnn", Category::RegisterAccess> {
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("A, R{}", getRegisterName(n::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), getRegisterName(n::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>(getRegisterName(n::get(bytes))),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -656,15 +708,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVBitC : public Instruction8051<"mov", "1001'0010'bbbb'bbbb", Category::RegisterAccess> {
         using b = Placeholder<'b'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, C", getBitName(b::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, C"), getBitName(b::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeFlag>("C"),
-                            create<ASTNodeFlag>(getBitName(b::get(bytes)))
+                            create<ASTNodeFlag>(FlagC),
+                            create<ASTNodeFlag>(RegisterId(b::get(bytes)))
                     )
             );
         }
@@ -673,15 +725,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVCBit : public Instruction8051<"mov", "1010'0010'bbbb'bbbb", Category::RegisterAccess> {
         using b = Placeholder<'b'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("C, {}", getBitName(b::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("C, {}"), getBitName(b::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeFlag>(getBitName(b::get(bytes))),
-                            create<ASTNodeFlag>("C")
+                            create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                            create<ASTNodeFlag>(FlagC)
                     )
             );
         }
@@ -691,15 +743,15 @@ namespace dc::disasm::i8051 {
         using s = Placeholder<'s'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, {}", getRegisterName(d::get(bytes)), getRegisterName(s::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, {}"), getRegisterName(d::get(bytes)), getRegisterName(s::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>(getRegisterName(s::get(bytes))),
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(s::get(bytes))),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
                     )
             );
         }
@@ -709,15 +761,15 @@ namespace dc::disasm::i8051 {
         using d = Placeholder<'d'>;
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, #0x{:02}", getRegisterName(d::get(bytes)), i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02}"), getRegisterName(d::get(bytes)), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(i::get(bytes)),
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
                     )
             );
         }
@@ -727,18 +779,18 @@ namespace dc::disasm::i8051 {
         using n = Placeholder<'n'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, @R{}", getRegisterName(d::get(bytes)), n::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, @R{}"), getRegisterName(d::get(bytes)), n::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             ),
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
                     )
             );
         }
@@ -747,15 +799,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVDirectA : public Instruction8051<"mov", "1111'0101'dddd'dddd", Category::RegisterAccess> {
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, A", getRegisterName(d::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, A"), getRegisterName(d::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>("A"),
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes)))
+                            create<ASTNodeRegister>(RegisterA),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
                     )
             );
         }
@@ -765,15 +817,15 @@ namespace dc::disasm::i8051 {
         using n = Placeholder<'n'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("{}, R{}", getRegisterName(d::get(bytes)), n::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, R{}"), getRegisterName(d::get(bytes)), n::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))),
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
                     )
             );
         }
@@ -782,15 +834,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVDptrImmediate : public Instruction8051<"mov", "1001'0000'iiii'iiii'iiii'iiii", Category::RegisterAccess> {
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("DPTR, #0x{:04X}", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("DPTR, #0x{:04X}"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(i::get(bytes)),
-                            create<ASTNodeRegister>("DPTR")
+                            create<ASTNodeRegister>(RegisterDPTR)
                     )
             );
         }
@@ -800,15 +852,15 @@ namespace dc::disasm::i8051 {
         using n = Placeholder<'n'>;
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("R{}, #0x{:04X}", n::get(bytes), i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}, #0x{:04X}"), n::get(bytes), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeIntegerLiteral>(i::get(bytes)),
-                            create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes)))
                     )
             );
         }
@@ -817,15 +869,15 @@ namespace dc::disasm::i8051 {
     struct InstrMOVRegA : public Instruction8051<"mov", "1111'1nnn", Category::RegisterAccess> {
         using n = Placeholder<'n'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("R{}, A", n::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}, A"), n::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>("A"),
-                            create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes)))
+                            create<ASTNodeRegister>(RegisterA),
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes)))
                     )
             );
         }
@@ -835,15 +887,15 @@ namespace dc::disasm::i8051 {
         using n = Placeholder<'n'>;
         using d = Placeholder<'d'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("R{}, {}", n::get(bytes), getRegisterName(d::get(bytes)));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}, {}"), n::get(bytes), getRegisterName(d::get(bytes)));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>(getRegisterName(d::get(bytes))),
-                            create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes)))
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes)))
                     )
             );
         }
@@ -851,11 +903,9 @@ namespace dc::disasm::i8051 {
 
     struct InstrRET : public Instruction8051<"ret", "0010'0010", Category::FunctionReturn> {
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "";
-        }
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeControlFlowStatement>(ASTNodeControlFlowStatement::Type::Return)
             );
@@ -864,11 +914,9 @@ namespace dc::disasm::i8051 {
 
     struct InstrRETI : public Instruction8051<"reti", "0011'0010", Category::FunctionReturn> {
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "";
-        }
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeControlFlowStatement>(ASTNodeControlFlowStatement::Type::Return)
             );
@@ -878,16 +926,16 @@ namespace dc::disasm::i8051 {
     struct InstrMOVXRegAddrA : public Instruction8051<"movx", "1111'001i", Category::MemoryAccess> {
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("@R{}, A", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}, A"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>("A"),
+                            create<ASTNodeRegister>(RegisterA),
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>(fmt::format("R{}", i::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(i::get(bytes))),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             )
                     )
@@ -896,34 +944,34 @@ namespace dc::disasm::i8051 {
     };
 
     struct InstrMOVXADPTRAddr : public Instruction8051<"movx", "1110'0000", Category::MemoryAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "A, @DPTR";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A, @DPTR"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>("DPTR"),
+                                    create<ASTNodeRegister>(RegisterDPTR),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             ),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
     };
 
     struct InstrMOVXDPTRAddrA : public Instruction8051<"movx", "1111'0000", Category::MemoryAccess> {
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return "@DPTR, A";
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("@DPTR, A"));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8>) {
             return asVector(
                     create<ASTNodeAssignment>(
-                            create<ASTNodeRegister>("A"),
+                            create<ASTNodeRegister>(RegisterA),
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>("DPTR"),
+                                    create<ASTNodeRegister>(RegisterDPTR),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             )
                     )
@@ -934,18 +982,18 @@ namespace dc::disasm::i8051 {
     struct InstrMOVXARegAddr : public Instruction8051<"movx", "1110'001i", Category::MemoryAccess> {
         using i = Placeholder<'i'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("A, @R{}", i::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeUnaryArithmetic>(
-                                    create<ASTNodeRegister>(fmt::format("R{}", i::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterId(i::get(bytes))),
                                     ASTNodeUnaryArithmetic::Operator::Dereference
                             ),
-                            create<ASTNodeRegister>("A")
+                            create<ASTNodeRegister>(RegisterA)
                     )
             );
         }
@@ -954,11 +1002,11 @@ namespace dc::disasm::i8051 {
     struct InstrLCall : public Instruction8051<"lcall", "0001'0010'aaaa'aaaa'aaaa'aaaa", Category::FunctionCall> {
         using a = Placeholder<'a'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", a::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), a::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeFunctionCall>(create<ASTNodeIntegerLiteral>(a::get(bytes)))
             );
@@ -968,11 +1016,11 @@ namespace dc::disasm::i8051 {
     struct InstrACall : public Instruction8051<"acall", "aaa1'0001'aaaa'aaaa", Category::FunctionCall> {
         using a = Placeholder<'a'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}", a::get(bytes));
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), a::get(bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeFunctionCall>(create<ASTNodeIntegerLiteral>(a::get(bytes)))
             );
@@ -983,11 +1031,11 @@ namespace dc::disasm::i8051 {
         using d = Placeholder<'d'>;
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("#0x{:02X}, #0x{:02X}", d::get(bytes), address + o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}, #0x{:02X}"), d::get(bytes), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
@@ -1009,7 +1057,7 @@ namespace dc::disasm::i8051 {
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -1021,24 +1069,24 @@ namespace dc::disasm::i8051 {
         using n = Placeholder<'n'>;
         using o = Placeholder<'o'>;
 
-        static std::string disassemble(u64 address, std::span<const u8> bytes) {
-            return fmt::format("R{}, #0x{:02X}", n::get(bytes), address + o::get(bytes));
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}, #0x{:02X}"), n::get(bytes), getRelativeTarget<o>(address, bytes));
         }
 
-        static std::vector<std::unique_ptr<ASTNode>> decompile(u64 address, std::span<const u8> bytes) {
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
             return asVector(
                     create<ASTNodeAssignment>(
                             create<ASTNodeBinaryArithmetic>(
-                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
                                     create<ASTNodeIntegerLiteral>(1),
                                     ASTNodeBinaryArithmetic::Operator::Subtract
                             ),
-                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference)
+                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference)
                     ),
                     create<ASTNodeConditional>(
                             create<ASTNodeBinaryArithmetic>(
                                     create<ASTNodeBinaryArithmetic>(
-                                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(fmt::format("R{}", n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
                                             create<ASTNodeIntegerLiteral>(1),
                                             ASTNodeBinaryArithmetic::Operator::Subtract
                                     ),
@@ -1047,7 +1095,7 @@ namespace dc::disasm::i8051 {
                             ),
                             asVector(
                                     create<ASTNodeJump>(
-                                            create<ASTNodeIntegerLiteral>(address + o::get(bytes) + 2)
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
                                     )
                             ),
                             asVector())
@@ -1056,61 +1104,1401 @@ namespace dc::disasm::i8051 {
     };
 
 
-    struct Architecture {
-        constexpr static auto InstructionSizeMin = 1;
+    struct InstrADDAImmediate : public Instruction8051<"add", "0010'0100'iiii'iiii", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDADirect : public Instruction8051<"add", "0010'0101'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDARegAddr : public Instruction8051<"add", "0010'011i", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDAReg : public Instruction8051<"add", "0010'1nnn", Category::Arithmetic> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDCAImmediate : public Instruction8051<"addc", "0011'0100'iiii'iiii", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                            ASTNodeBinaryArithmetic::Operator::Add
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDCADirect : public Instruction8051<"addc", "0011'0101'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                            ASTNodeBinaryArithmetic::Operator::Add
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDCARegAddr : public Instruction8051<"addc", "0011'011i", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                            ASTNodeBinaryArithmetic::Operator::Add
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrADDCAReg : public Instruction8051<"addc", "0011'1nnn", Category::Arithmetic> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                            ASTNodeBinaryArithmetic::Operator::Add
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrORLAImmediate : public Instruction8051<"orl", "0100'0100'iiii'iiii", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BitOr
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrORLADirect : public Instruction8051<"orl", "0100'0101'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BitOr
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrORLARegAddr : public Instruction8051<"orl", "0100'011i", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    ASTNodeBinaryArithmetic::Operator::BitOr
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrORLAReg : public Instruction8051<"orl", "0100'1nnn", Category::Arithmetic> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BitOr
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrANLAImmediate : public Instruction8051<"anl", "0101'0100'iiii'iiii", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BitAnd
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrANLADirect : public Instruction8051<"anl", "0101'0101'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BitAnd
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrANLARegAddr : public Instruction8051<"anl", "0101'011i", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    ASTNodeBinaryArithmetic::Operator::BitAnd
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrANLAReg : public Instruction8051<"anl", "0101'1nnn", Category::Arithmetic> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BitAnd
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrXRLAImmediate : public Instruction8051<"xrl", "0110'0100'iiii'iiii", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BitXor
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrXRLADirect : public Instruction8051<"xrl", "0110'0101'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BitXor
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrXRLARegAddr : public Instruction8051<"xrl", "0110'011i", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    ASTNodeBinaryArithmetic::Operator::BitXor
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrXRLAReg : public Instruction8051<"xrl", "0110'1nnn", Category::Arithmetic> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BitXor
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrSUBBAImmediate : public Instruction8051<"subb", "1001'0100'iiii'iiii", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                            ASTNodeBinaryArithmetic::Operator::Subtract
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrSUBBADirect : public Instruction8051<"subb", "1001'0101'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                            ASTNodeBinaryArithmetic::Operator::Subtract
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrSUBBARegAddr : public Instruction8051<"subb", "1001'011i", Category::Arithmetic> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                            ASTNodeBinaryArithmetic::Operator::Subtract
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrSUBBAReg : public Instruction8051<"subb", "1001'1nnn", Category::Arithmetic> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                            ASTNodeBinaryArithmetic::Operator::Subtract
+                                    ),
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrORLDirectA : public Instruction8051<"orl", "0100'0010'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, A"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterA),
+                                    ASTNodeBinaryArithmetic::Operator::BitOr
+                            ),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrORLDirectImmediate : public Instruction8051<"orl", "0100'0011'dddd'dddd'iiii'iiii", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02X}"), getRegisterName(d::get(bytes)), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BitOr
+                            ),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrANLDirectA : public Instruction8051<"anl", "0101'0010'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, A"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterA),
+                                    ASTNodeBinaryArithmetic::Operator::BitAnd
+                            ),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrANLDirectImmediate : public Instruction8051<"anl", "0101'0011'dddd'dddd'iiii'iiii", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02X}"), getRegisterName(d::get(bytes)), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BitAnd
+                            ),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrXRLDirectA : public Instruction8051<"xrl", "0110'0010'dddd'dddd", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, A"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    create<ASTNodeRegister>(RegisterA),
+                                    ASTNodeBinaryArithmetic::Operator::BitXor
+                            ),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrXRLDirectImmediate : public Instruction8051<"xrl", "0110'0011'dddd'dddd'iiii'iiii", Category::Arithmetic> {
+        using d = Placeholder<'d'>;
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02X}"), getRegisterName(d::get(bytes)), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BitXor
+                            ),
+                            create<ASTNodeRegister>(RegisterId(d::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrORLCBit : public Instruction8051<"orl", "0111'0010'bbbb'bbbb", Category::Arithmetic> {
+        using b = Placeholder<'b'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("C, {}"), getBitName(b::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeFlag>(FlagC),
+                                    create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BoolOr
+                            ),
+                            create<ASTNodeFlag>(FlagC)
+                    )
+            );
+        }
+    };
+
+    struct InstrANLCBit : public Instruction8051<"anl", "1000'0010'bbbb'bbbb", Category::Arithmetic> {
+        using b = Placeholder<'b'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("C, {}"), getBitName(b::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeFlag>(FlagC),
+                                    create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BoolAnd
+                            ),
+                            create<ASTNodeFlag>(FlagC)
+                    )
+            );
+        }
+    };
+
+    struct InstrORLCNotBit : public Instruction8051<"orl", "1010'0000'bbbb'bbbb", Category::Arithmetic> {
+        using b = Placeholder<'b'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("C, /{}"), getBitName(b::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeFlag>(FlagC),
+                                    create<ASTNodeUnaryArithmetic>(
+                                            create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                                            ASTNodeUnaryArithmetic::Operator::BoolNot
+                                    ),
+                                    ASTNodeBinaryArithmetic::Operator::BoolOr
+                            ),
+                            create<ASTNodeFlag>(FlagC)
+                    )
+            );
+        }
+    };
+
+    struct InstrANLCNotBit : public Instruction8051<"anl", "1011'0000'bbbb'bbbb", Category::Arithmetic> {
+        using b = Placeholder<'b'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("C, /{}"), getBitName(b::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeFlag>(FlagC),
+                                    create<ASTNodeUnaryArithmetic>(
+                                            create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                                            ASTNodeUnaryArithmetic::Operator::BoolNot
+                                    ),
+                                    ASTNodeBinaryArithmetic::Operator::BoolAnd
+                            ),
+                            create<ASTNodeFlag>(FlagC)
+                    )
+            );
+        }
+    };
+
+    struct InstrCPLBit : public Instruction8051<"cpl", "1011'0010'bbbb'bbbb", Category::MemoryAccess> {
+        using b = Placeholder<'b'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}"), getBitName(b::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeUnaryArithmetic>(
+                                    create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                                    ASTNodeUnaryArithmetic::Operator::BoolNot
+                            ),
+                            create<ASTNodeFlag>(RegisterId(b::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrCPLC : public Instruction8051<"cpl", "1011'0011", Category::RegisterAccess> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("C"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeUnaryArithmetic>(
+                                    create<ASTNodeFlag>(FlagC),
+                                    ASTNodeUnaryArithmetic::Operator::BoolNot
+                            ),
+                            create<ASTNodeFlag>(FlagC)
+                    )
+            );
+        }
+    };
+
+    struct InstrDecA : public Instruction8051<"dec", "0001'0100", Category::RegisterAccess> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(1),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrDecDirect : public Instruction8051<"dec", "0001'0101'dddd'dddd", Category::MemoryAccess> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("#0x{:02X}"), d::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeIntegerLiteral>(d::get(bytes)), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    create<ASTNodeIntegerLiteral>(1),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeUnaryArithmetic>(create<ASTNodeIntegerLiteral>(d::get(bytes)), ASTNodeUnaryArithmetic::Operator::Dereference)
+                    )
+            );
+        }
+    };
+
+    struct InstrDecIndirect : public Instruction8051<"dec", "0001'011i", Category::MemoryAccess> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    create<ASTNodeIntegerLiteral>(1),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(i::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference)
+                    )
+            );
+        }
+    };
+
+    struct InstrDecR : public Instruction8051<"dec", "0001'1nnn", Category::RegisterAccess> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                    create<ASTNodeIntegerLiteral>(1),
+                                    ASTNodeBinaryArithmetic::Operator::Subtract
+                            ),
+                            create<ASTNodeRegister>(RegisterId(n::get(bytes)))
+                    )
+            );
+        }
+    };
+
+    struct InstrRRC : public Instruction8051<"rrc", "0001'0011", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssembly>("rrc A")
+            );
+        }
+    };
+
+    struct InstrRL : public Instruction8051<"rl", "0010'0011", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(1),
+                                    ASTNodeBinaryArithmetic::Operator::RotateLeft
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrRLC : public Instruction8051<"rlc", "0011'0011", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssembly>("rlc A")
+            );
+        }
+    };
+
+    struct InstrSWAP : public Instruction8051<"swap", "1100'0100", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(4),
+                                    ASTNodeBinaryArithmetic::Operator::RotateLeft
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrDA : public Instruction8051<"da", "1101'0100", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssembly>("da A")
+            );
+        }
+    };
+
+    struct InstrMUL : public Instruction8051<"mul", "1010'0100", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("AB"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssembly>("mul AB")
+            );
+        }
+    };
+
+    struct InstrDIV : public Instruction8051<"div", "1000'0100", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("AB"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssembly>("div AB")
+            );
+        }
+    };
+
+    struct InstrCPLA : public Instruction8051<"cpl", "1111'0100", Category::Arithmetic> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeUnaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    ASTNodeUnaryArithmetic::Operator::BitNot
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrJBC : public Instruction8051<"jbc", "0001'0000'bbbb'bbbb'oooo'oooo", Category::ConditionalJump> {
+        using b = Placeholder<'b'>;
+        using o = Placeholder<'o'>;
+
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}, #0x{:02X}"), getBitName(b::get(bytes)), getRelativeTarget<o>(address, bytes));
+        }
+
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeConditional>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeFlag>(RegisterId(b::get(bytes))),
+                                    create<ASTNodeIntegerLiteral>(1),
+                                    ASTNodeBinaryArithmetic::Operator::BoolEqual
+                            ),
+                            asVector(
+                                    create<ASTNodeAssignment>(
+                                            create<ASTNodeIntegerLiteral>(0),
+                                            create<ASTNodeFlag>(RegisterId(b::get(bytes)))
+                                    ),
+                                    create<ASTNodeJump>(
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
+                                    )
+                            ),
+                            asVector())
+            );
+        }
+    };
+
+    struct InstrJMPIndirect : public Instruction8051<"jmp", "0111'0011", Category::UnconditionalJump> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("@A+DPTR"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeJump>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterDPTR),
+                                    ASTNodeBinaryArithmetic::Operator::Add
+                            )
+                    )
+            );
+        }
+    };
+
+    struct InstrCJNEAImmediate : public Instruction8051<"cjne", "1011'0100'iiii'iiii'oooo'oooo", Category::ConditionalJump> {
+        using i = Placeholder<'i'>;
+        using o = Placeholder<'o'>;
+
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, #0x{:02X}, #0x{:02X}"), i::get(bytes), getRelativeTarget<o>(address, bytes));
+        }
+
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeConditional>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BoolNotEqual
+                            ),
+                            asVector(
+                                    create<ASTNodeJump>(
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
+                                    )
+                            ),
+                            asVector())
+            );
+        }
+    };
+
+    struct InstrCJNEADirect : public Instruction8051<"cjne", "1011'0101'dddd'dddd'oooo'oooo", Category::ConditionalJump> {
+        using d = Placeholder<'d'>;
+        using o = Placeholder<'o'>;
+
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}, #0x{:02X}"), getRegisterName(d::get(bytes)), getRelativeTarget<o>(address, bytes));
+        }
+
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeConditional>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterA),
+                                    create<ASTNodeRegister>(RegisterId(d::get(bytes))),
+                                    ASTNodeBinaryArithmetic::Operator::BoolNotEqual
+                            ),
+                            asVector(
+                                    create<ASTNodeJump>(
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
+                                    )
+                            ),
+                            asVector())
+            );
+        }
+    };
+
+    struct InstrCJNERegAddrImmediate : public Instruction8051<"cjne", "1011'011n'iiii'iiii'oooo'oooo", Category::ConditionalJump> {
+        using n = Placeholder<'n'>;
+        using i = Placeholder<'i'>;
+        using o = Placeholder<'o'>;
+
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("@R{}, #0x{:02X}, #0x{:02X}"), n::get(bytes), i::get(bytes), getRelativeTarget<o>(address, bytes));
+        }
+
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeConditional>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(RegisterId(n::get(bytes))), ASTNodeUnaryArithmetic::Operator::Dereference),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BoolNotEqual
+                            ),
+                            asVector(
+                                    create<ASTNodeJump>(
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
+                                    )
+                            ),
+                            asVector())
+            );
+        }
+    };
+
+    struct InstrCJNERegImmediate : public Instruction8051<"cjne", "1011'1nnn'iiii'iiii'oooo'oooo", Category::ConditionalJump> {
+        using n = Placeholder<'n'>;
+        using i = Placeholder<'i'>;
+        using o = Placeholder<'o'>;
+
+        static void disassemble(fmt::appender out, u64 address, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("R{}, #0x{:02X}, #0x{:02X}"), n::get(bytes), i::get(bytes), getRelativeTarget<o>(address, bytes));
+        }
+
+        static NodeList decompile(u64 address, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeConditional>(
+                            create<ASTNodeBinaryArithmetic>(
+                                    create<ASTNodeRegister>(RegisterId(n::get(bytes))),
+                                    create<ASTNodeIntegerLiteral>(i::get(bytes)),
+                                    ASTNodeBinaryArithmetic::Operator::BoolNotEqual
+                            ),
+                            asVector(
+                                    create<ASTNodeJump>(
+                                            create<ASTNodeIntegerLiteral>(getRelativeTarget<o>(address, bytes))
+                                    )
+                            ),
+                            asVector())
+            );
+        }
+    };
+
+    struct InstrMOVCAPC : public Instruction8051<"movc", "1000'0011", Category::MemoryAccess> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A, @A+PC"));
+        }
+
+        static NodeList decompile(u64 address, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeUnaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeIntegerLiteral>(address + 1),
+                                            ASTNodeBinaryArithmetic::Operator::Add
+                                    ),
+                                    ASTNodeUnaryArithmetic::Operator::Dereference
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrMOVCADPTR : public Instruction8051<"movc", "1001'0011", Category::MemoryAccess> {
+        static void disassemble(fmt::appender out, u64, std::span<const u8>) {
+            fmt::format_to(out, FMT_COMPILE("A, @A+DPTR"));
+        }
+
+        static NodeList decompile(u64, std::span<const u8>) {
+            return asVector(
+                    create<ASTNodeAssignment>(
+                            create<ASTNodeUnaryArithmetic>(
+                                    create<ASTNodeBinaryArithmetic>(
+                                            create<ASTNodeRegister>(RegisterA),
+                                            create<ASTNodeRegister>(RegisterDPTR),
+                                            ASTNodeBinaryArithmetic::Operator::Add
+                                    ),
+                                    ASTNodeUnaryArithmetic::Operator::Dereference
+                            ),
+                            create<ASTNodeRegister>(RegisterA)
+                    )
+            );
+        }
+    };
+
+    struct InstrPUSH : public Instruction8051<"push", "1100'0000'dddd'dddd", Category::MemoryAccess> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssembly>(fmt::format("push {}", getRegisterName(d::get(bytes))))
+            );
+        }
+    };
+
+    struct InstrPOP : public Instruction8051<"pop", "1101'0000'dddd'dddd", Category::MemoryAccess> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("{}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssembly>(fmt::format("pop {}", getRegisterName(d::get(bytes))))
+            );
+        }
+    };
+
+    struct InstrXCHADirect : public Instruction8051<"xch", "1100'0101'dddd'dddd", Category::RegisterAccess> {
+        using d = Placeholder<'d'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, {}"), getRegisterName(d::get(bytes)));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssembly>(fmt::format("xch A, {}", getRegisterName(d::get(bytes))))
+            );
+        }
+    };
+
+    struct InstrXCHARegAddr : public Instruction8051<"xch", "1100'011i", Category::MemoryAccess> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssembly>(fmt::format("xch A, @R{}", i::get(bytes)))
+            );
+        }
+    };
+
+    struct InstrXCHAReg : public Instruction8051<"xch", "1100'1nnn", Category::RegisterAccess> {
+        using n = Placeholder<'n'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, R{}"), n::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssembly>(fmt::format("xch A, R{}", n::get(bytes)))
+            );
+        }
+    };
+
+    struct InstrXCHDARegAddr : public Instruction8051<"xchd", "1101'011i", Category::MemoryAccess> {
+        using i = Placeholder<'i'>;
+
+        static void disassemble(fmt::appender out, u64, std::span<const u8> bytes) {
+            fmt::format_to(out, FMT_COMPILE("A, @R{}"), i::get(bytes));
+        }
+
+        static NodeList decompile(u64, std::span<const u8> bytes) {
+            return asVector(
+                    create<ASTNodeAssembly>(fmt::format("xchd A, @R{}", i::get(bytes)))
+            );
+        }
+    };
+
+    struct Architecture {
+        constexpr static auto InstructionSizeMin = 1;
+
+        constexpr static auto &Registers = RegisterNames;
+        constexpr static auto &Flags = FlagNames;
+
+        using Instructions = OrderBySpecificity<InstructionArray<
+                InstrNop,
+                InstrAJmp,
+                InstrLJmp,
+                InstrSJmp,
+                InstrRR,
+                InstrIncR,
+                InstrIncDPTR,
+                InstrIncA,
+                InstrIncDirect,
+                InstrIncIndirect,
+                InstrJC,
+                InstrJNC,
+                InstrJZ,
+                InstrJNZ,
+                InstrJNB,
+                InstrJB,
+                InstrCLRBit,
+                InstrCLRC,
+                InstrCLRA,
+                InstrMOVRegAddrImmediate,
+                InstrMOVRegAddrA,
+                InstrMOVRegAddrDirect,
+                InstrMOVAImmediate,
+                InstrMOVARegAddr,
+                InstrMOVADirect,
+                InstrMOVAReg,
+                InstrMOVBitC,
+                InstrMOVCBit,
+                InstrMOVDirectDirect,
+                InstrMOVDirectImmediate,
+                InstrMOVDirectRegAddr,
+                InstrMOVDirectA,
+                InstrMOVDirectReg,
+                InstrMOVDptrImmediate,
+                InstrMOVRegImmediate,
+                InstrMOVRegA,
+                InstrMOVRegDirect,
+                InstrRET,
+                InstrRETI,
+                InstrSETBC,
+                InstrSETBBit,
+                InstrMOVXRegAddrA,
+                InstrMOVXADPTRAddr,
+                InstrMOVXDPTRAddrA,
+                InstrMOVXARegAddr,
+                InstrLCall,
+                InstrACall,
+                InstrDJNZDirectOffset,
+                InstrDJNZRegisterOffset,
+                InstrADDAImmediate,
+                InstrADDADirect,
+                InstrADDARegAddr,
+                InstrADDAReg,
+                InstrADDCAImmediate,
+                InstrADDCADirect,
+                InstrADDCARegAddr,
+                InstrADDCAReg,
+                InstrORLAImmediate,
+                InstrORLADirect,
+                InstrORLARegAddr,
+                InstrORLAReg,
+                InstrANLAImmediate,
+                InstrANLADirect,
+                InstrANLARegAddr,
+                InstrANLAReg,
+                InstrXRLAImmediate,
+                InstrXRLADirect,
+                InstrXRLARegAddr,
+                InstrXRLAReg,
+                InstrSUBBAImmediate,
+                InstrSUBBADirect,
+                InstrSUBBARegAddr,
+                InstrSUBBAReg,
+                InstrORLDirectA,
+                InstrORLDirectImmediate,
+                InstrANLDirectA,
+                InstrANLDirectImmediate,
+                InstrXRLDirectA,
+                InstrXRLDirectImmediate,
+                InstrORLCBit,
+                InstrANLCBit,
+                InstrORLCNotBit,
+                InstrANLCNotBit,
+                InstrCPLBit,
+                InstrCPLC,
+                InstrDecA,
+                InstrDecDirect,
+                InstrDecIndirect,
+                InstrDecR,
+                InstrRRC,
+                InstrRL,
+                InstrRLC,
+                InstrSWAP,
+                InstrDA,
+                InstrMUL,
+                InstrDIV,
+                InstrCPLA,
+                InstrJBC,
+                InstrJMPIndirect,
+                InstrCJNEAImmediate,
+                InstrCJNEADirect,
+                InstrCJNERegAddrImmediate,
+                InstrCJNERegImmediate,
+                InstrMOVCAPC,
+                InstrMOVCADPTR,
+                InstrPUSH,
+                InstrPOP,
+                InstrXCHADirect,
+                InstrXCHARegAddr,
+                InstrXCHAReg,
+                InstrXCHDARegAddr
+        >>;
+    };
 
-        using Instructions = InstructionArray<
-                InstrNop,
-                InstrAJmp,
-                InstrLJmp,
-                InstrSJmp,
-                InstrRR,
-                InstrIncR,
-                InstrIncDPTR,
-                InstrIncA,
-                InstrIncDirect,
-                InstrIncIndirect,
-                InstrJC,
-                InstrJNC,
-                InstrJZ,
-                InstrJNZ,
-                InstrJNB,
-                InstrJB,
-                InstrCLRBit,
-                InstrCLRC,
-                InstrCLRA,
-                InstrMOVRegAddrImmediate,
-                InstrMOVRegAddrA,
-                InstrMOVRegAddrDirect,
-                InstrMOVAImmediate,
-                InstrMOVARegAddr,
-                InstrMOVADirect,
-                InstrMOVAReg,
-                InstrMOVBitC,
-                InstrMOVCBit,
-                InstrMOVDirectDirect,
-                InstrMOVDirectImmediate,
-                InstrMOVDirectRegAddr,
-                InstrMOVDirectA,
-                InstrMOVDirectReg,
-                InstrMOVDptrImmediate,
-                InstrMOVRegImmediate,
-                InstrMOVRegA,
-                InstrMOVRegDirect,
-                InstrRET,
-                InstrRETI,
-                InstrSETBC,
-                InstrSETBBit,
-                InstrMOVXRegAddrA,
-                InstrMOVXADPTRAddr,
-                InstrMOVXDPTRAddrA,
-                InstrMOVXARegAddr,
-                InstrLCall,
-                InstrACall,
-                InstrDJNZDirectOffset,
-                InstrDJNZRegisterOffset
-        >;
-    };
 
+}
 
-}
\ No newline at end of file
+DC_EXTERN_ARCHITECTURE(dc::disasm::i8051::Architecture);
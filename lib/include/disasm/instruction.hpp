@@ -3,8 +3,10 @@
 #include <dc.hpp>
 #include <ast/ast_node.hpp>
 #include <helpers/bit_pattern.hpp>
+#include <helpers/static_string.hpp>
 #include <helpers/type_array.hpp>
 
+#include <tuple>
 #include <vector>
 #include <fmt/format.h>
 #include <fmt/compile.h>
@@ -12,14 +14,57 @@
 namespace dc::disasm {
 
     template<typename T>
-    concept InstructionType = requires(u64 address, std::vector<u8> &&data) {
+    concept InstructionType = requires(fmt::appender out, u64 address, std::vector<u8> &&data) {
         typename T::Pattern;
         T::Mnemonic;
-        { T::disassemble(address, data) } -> std::same_as<std::string>;
-        { T::decompile(address, data) } -> std::same_as<std::vector<std::unique_ptr<ast::ASTNode>>>;
+        { T::disassemble(out, address, data) } -> std::same_as<void>;
+        { T::decompile(address, data) } -> std::same_as<ast::NodeList>;
         requires (sizeof(T) == sizeof(hlp::Empty));
     };
 
+    /*
+     * Format string known at compile time that fmt compiles the same way as one passed through FMT_COMPILE.
+     * Unlike a FMT_COMPILE literal it can be assembled from smaller strings in constant evaluation.
+     *
+     * fmt's public API only compiles string literals, FMT_COMPILE and _cf both expand to a type derived from
+     * fmt::detail::compiled_string. Deriving from that internal type directly is the only way to get the same
+     * for a string built from a template parameter, so it's limited to the fmt versions this was checked against.
+     */
+    static_assert(FMT_VERSION >= 80000 && FMT_VERSION < 120000, "CompiledFormatString relies on fmt::detail::compiled_string, check it against this fmt version");
+
+    template<hlp::StaticString Format>
+    struct CompiledFormatString : fmt::detail::compiled_string {
+        using char_type = char;
+
+        constexpr explicit operator fmt::string_view() const {
+            return { Format.data, Format.size() };
+        }
+    };
+
+    static_assert(fmt::detail::is_compiled_string<CompiledFormatString<"">>::value, "fmt doesn't treat CompiledFormatString as a compiled format string");
+
+    /*
+     * Instruction operand made up of a compile time format string and a function reading the values of its
+     * replacement fields from the instruction bytes, as a tuple
+     */
+    template<hlp::StaticString FormatValue, typename Getter>
+    struct Operand {
+        constexpr static auto Format = FormatValue;
+
+        Getter getValues;
+
+        void operator()(fmt::appender out, const auto &bytes) const {
+            std::apply([out](const auto &... values) {
+                fmt::format_to(out, CompiledFormatString<Format>(), values...);
+            }, this->getValues(bytes));
+        }
+    };
+
+    template<hlp::StaticString Format, typename Getter>
+    constexpr auto makeOperand(Getter getter) {
+        return Operand<Format, Getter> { getter };
+    }
+
     template<InstructionType ... Ts>
     struct InstructionArray : public hlp::TypeArray<Ts...> {};
 
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <disasm/architecture.hpp>
+#include <disasm/decode.hpp>
+#include <disasm/opcode_table.hpp>
+#include <disasm/parallel.hpp>
+#include <helpers/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <span>
+#include <vector>
+
+namespace dc::disasm {
+
+    /*
+     * Instruction length of every possible leading byte, derived from the patterns' byte counts.
+     * A leading byte's length is only known up front if the first instruction that can start with it has no fixed bits
+     * outside of the leading byte, since that instruction then always matches. All other leading bytes need to go through the decoder.
+     */
+    template<ArchitectureType T>
+    class InstructionLengthTable {
+    public:
+        /* Marks leading bytes whose instruction length can't be determined without decoding the instruction */
+        constexpr static u8 Unknown = 0x00;
+
+        constexpr static size_t LeadingByteOffset = T::Instructions::template Get<0>::Pattern::getLeadingByteOffset();
+
+        [[nodiscard]]
+        constexpr static u8 getLength(u8 leadingByte) {
+            return Lengths[leadingByte];
+        }
+
+        [[nodiscard]]
+        constexpr static u8 getByteCount(size_t index) {
+            return ByteCounts[index];
+        }
+
+        [[nodiscard]]
+        consteval static size_t getMaxInstructionSize() {
+            return std::max<size_t>(T::InstructionSizeMin, *std::max_element(ByteCounts.begin(), ByteCounts.end()));
+        }
+
+    private:
+        struct PatternInfo {
+            u8 mask, compareValue, byteCount;
+            bool onlyLeadingByteFixed;
+        };
+
+        template<typename ... Instrs>
+        consteval static auto getPatternInfos(const hlp::TypeArray<Instrs...> &) {
+            constexpr auto getInfo = []<typename Pattern>() {
+                constexpr auto Mask = Pattern::getBitMask();
+
+                return PatternInfo {
+                    Mask[0],
+                    Pattern::getBitCompareValues()[0],
+                    u8(Pattern::getByteCount()),
+                    std::all_of(Mask.begin() + 1, Mask.end(), [](u8 byte) { return byte == 0x00; })
+                };
+            };
+
+            return std::array<PatternInfo, T::Instructions::Size> { getInfo.template operator()<typename Instrs::Pattern>()... };
+        }
+
+        consteval static auto generateLengths() {
+            std::array<u8, 256> result = { };
+
+            for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+                const auto candidate = std::find_if(Patterns.begin(), Patterns.end(), [byte](const auto &pattern) {
+                    return (byte & pattern.mask) == pattern.compareValue;
+                });
+
+                if (candidate == Patterns.end())
+                    result[byte] = T::InstructionSizeMin;
+                else if (candidate->onlyLeadingByteFixed)
+                    result[byte] = candidate->byteCount;
+                else
+                    result[byte] = Unknown;
+            }
+
+            return result;
+        }
+
+        consteval static auto generateByteCounts() {
+            std::array<u8, T::Instructions::Size> result = { };
+            for (size_t i = 0; i < Patterns.size(); i++)
+                result[i] = Patterns[i].byteCount;
+
+            return result;
+        }
+
+        constexpr static auto Patterns   = getPatternInfos(typename T::Instructions{ });
+        constexpr static auto Lengths    = generateLengths();
+        constexpr static auto ByteCounts = generateByteCounts();
+    };
+
+    namespace {
+
+        template<ArchitectureType T, template<typename> typename Decoder>
+        void computeInstructionLengths(std::span<const u8> bytes, std::span<u8> lengths, u64 begin, u64 end) {
+            using Table = InstructionLengthTable<T>;
+            using InstructionDecoder = Decoder<typename T::Instructions>;
+
+            // Offsets close to the end of the input might not have enough bytes left for the full instruction
+            const auto safeEnd = std::min<u64>(end, bytes.size() > Table::getMaxInstructionSize() ? bytes.size() - Table::getMaxInstructionSize() : 0);
+
+            for (u64 offset = begin; offset < safeEnd; offset++)
+                lengths[offset] = Table::getLength(bytes[offset + Table::LeadingByteOffset]);
+
+            for (u64 offset = begin; offset < end; offset++) {
+                if (offset < safeEnd && lengths[offset] != Table::Unknown)
+                    continue;
+
+                const auto instructionBytes = bytes.subspan(offset);
+                if (auto index = InstructionDecoder::find(instructionBytes); index != InstructionDecoder::NotFound)
+                    lengths[offset] = Table::getByteCount(index);
+                else
+                    lengths[offset] = std::min<size_t>(T::InstructionSizeMin, instructionBytes.size());
+            }
+        }
+
+    }
+
+    /*
+     * Computes the length of the instruction starting at every single byte offset of the input, the same length
+     * decodeInstruction would return there. Every offset is independent of all others so this runs on all threads
+     * and the plain table lookup is easily vectorized by the compiler.
+     */
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    std::vector<u8> getInstructionLengths(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+        std::vector<u8> lengths(bytes.size());
+
+        const auto chunkSize = getChunkSize<T>(bytes.size(), pool);
+
+        std::vector<std::future<void>> chunks;
+        for (u64 begin = 0x00; begin < bytes.size(); begin += chunkSize) {
+            const auto end = std::min<u64>(begin + chunkSize, bytes.size());
+            chunks.push_back(pool.submit([bytes, &lengths, begin, end] { computeInstructionLengths<T, Decoder>(bytes, lengths, begin, end); }));
+        }
+
+        for (auto &chunk : chunks)
+            chunk.get();
+
+        return lengths;
+    }
+
+    /*
+     * Finds the offsets of all instructions reached by sweeping from the entry offset, given the instruction length at every offset.
+     *
+     * The input is split into chunks. As instructions are at most MaxSize bytes long, the sweep can only enter a chunk at one
+     * of its first MaxSize offsets. For each chunk, the offset at which the sweep leaves it is computed for all of these entry
+     * points in parallel. Walks from different entry points usually merge after a few instructions, so all but the first one stop
+     * as soon as they reach an offset visited before. A cheap serial scan over these per-chunk transfer functions then yields
+     * the real entry offset of every chunk, after which all chunks are walked once more in parallel to collect the boundaries.
+     */
+    template<ArchitectureType T>
+    std::vector<u64> findInstructionBoundaries(std::span<const u8> lengths, hlp::ThreadPool &pool, u64 entry = 0x00) {
+        constexpr auto MaxSize = InstructionLengthTable<T>::getMaxInstructionSize();
+        using Transfer = std::array<u64, MaxSize>;
+
+        const auto chunkSize = std::max<size_t>(getChunkSize<T>(lengths.size(), pool), MaxSize);
+
+        std::vector<std::future<Transfer>> transfers;
+        for (u64 begin = entry; begin < lengths.size(); begin += chunkSize) {
+            const auto end = std::min<u64>(begin + chunkSize, lengths.size());
+            transfers.push_back(pool.submit([lengths, begin, end] {
+                Transfer result = { };
+                std::vector<bool> visited(end - begin);
+
+                for (size_t phase = 0; phase < MaxSize; phase++) {
+                    u64 offset = begin + phase;
+                    while (offset < end && !visited[offset - begin]) {
+                        if (phase == 0)
+                            visited[offset - begin] = true;
+                        offset += lengths[offset];
+                    }
+
+                    result[phase] = offset < end ? result[0] : offset;
+                }
+
+                return result;
+            }));
+        }
+
+        std::vector<u64> entries;
+        entries.reserve(transfers.size());
+
+        u64 offset = entry;
+        for (size_t i = 0; i < transfers.size(); i++) {
+            entries.push_back(offset);
+            offset = transfers[i].get()[offset - (entry + i * chunkSize)];
+        }
+
+        std::vector<std::future<std::vector<u64>>> chunks;
+        for (size_t i = 0; i < entries.size(); i++) {
+            const auto end = std::min<u64>(entry + (i + 1) * chunkSize, lengths.size());
+            chunks.push_back(pool.submit([lengths, begin = entries[i], end] {
+                std::vector<u64> boundaries;
+                for (u64 offset = begin; offset < end; offset += lengths[offset])
+                    boundaries.push_back(offset);
+
+                return boundaries;
+            }));
+        }
+
+        std::vector<u64> boundaries;
+        for (auto &chunk : chunks) {
+            const auto chunkBoundaries = chunk.get();
+            boundaries.insert(boundaries.end(), chunkBoundaries.begin(), chunkBoundaries.end());
+        }
+
+        return boundaries;
+    }
+
+    /*
+     * Data parallel alternative to decode for variable width instruction sets. Instruction lengths are computed at every offset,
+     * the instruction boundaries are found with a prefix scan and then all instructions are decoded in parallel.
+     * The result is identical to the one of the serial decode.
+     */
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    std::vector<DecodedInstruction<T>> decodeWithLengthTable(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+        const auto lengths    = getInstructionLengths<T, Decoder>(bytes, pool);
+        const auto boundaries = findInstructionBoundaries<T>(lengths, pool);
+
+        const auto chunkSize = std::max<size_t>(1, getChunkSize<T>(boundaries.size(), pool));
+
+        std::vector<std::future<std::vector<DecodedInstruction<T>>>> chunks;
+        for (size_t begin = 0; begin < boundaries.size(); begin += chunkSize) {
+            const auto end = std::min(begin + chunkSize, boundaries.size());
+            chunks.push_back(pool.submit([bytes, &boundaries, begin, end] {
+                std::vector<DecodedInstruction<T>> instructions;
+                instructions.reserve(end - begin);
+
+                for (size_t i = begin; i < end; i++)
+                    instructions.push_back(dc::disasm::decodeInstruction<T, Decoder>(boundaries[i], bytes));
+
+                return instructions;
+            }));
+        }
+
+        std::vector<DecodedInstruction<T>> instructions;
+        instructions.reserve(boundaries.size());
+        for (auto &chunk : chunks) {
+            const auto chunkInstructions = chunk.get();
+            instructions.insert(instructions.end(), chunkInstructions.begin(), chunkInstructions.end());
+        }
+
+        return mergeDataRecords<T, Decoder>(instructions, bytes);
+    }
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <disasm/architecture.hpp>
+#include <disasm/decode.hpp>
+#include <disasm/disassembler.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <string>
+
+namespace dc::disasm {
+
+    /*
+     * Lightweight handle to a single instruction produced by a LinearSweep.
+     * The disassembly text is only generated when asked for.
+     */
+    template<ArchitectureType T>
+    class InstructionView {
+    public:
+        constexpr InstructionView(const DecodedInstruction<T> &instruction, std::span<const u8> bytes)
+            : m_instruction(instruction), m_bytes(bytes) { }
+
+        [[nodiscard]] constexpr const DecodedInstruction<T>& getInstruction() const { return this->m_instruction; }
+        [[nodiscard]] constexpr u64 getOffset() const { return this->m_instruction.offset; }
+        [[nodiscard]] constexpr std::span<const u8> getBytes() const { return this->m_bytes.subspan(this->m_instruction.offset, this->m_instruction.length); }
+
+        [[nodiscard]] std::string disassemble() const {
+            return disassembleInstruction<T>(this->m_instruction, this->m_bytes);
+        }
+
+        void disassemble(fmt::memory_buffer &buffer) const {
+            disassembleInstruction<T>(buffer, this->m_instruction, this->m_bytes);
+        }
+
+    private:
+        DecodedInstruction<T> m_instruction;
+        std::span<const u8> m_bytes;
+    };
+
+    /*
+     * Input range decoding one instruction at a time while it's being iterated.
+     * Memory usage is independent of the size of the input and iteration can be stopped at any point.
+     */
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    class LinearSweep {
+    public:
+        class Iterator {
+        public:
+            using value_type        = InstructionView<T>;
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            Iterator() = default;
+            Iterator(std::span<const u8> bytes, u64 offset) : m_bytes(bytes) {
+                this->decodeAt(offset);
+            }
+
+            [[nodiscard]] value_type operator*() const {
+                return { this->m_instruction, this->m_bytes };
+            }
+
+            Iterator& operator++() {
+                this->decodeAt(this->m_instruction.offset + this->m_instruction.length);
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            [[nodiscard]] bool operator==(std::default_sentinel_t) const {
+                return this->m_instruction.length == 0;
+            }
+
+        private:
+            void decodeAt(u64 offset) {
+                if (offset < this->m_bytes.size())
+                    this->m_instruction = decodeNext<T, Decoder>(offset, this->m_bytes);
+                else
+                    this->m_instruction = { offset, 0, DecodedInstruction<T>::InvalidId, Category::Other, { } };
+            }
+
+            std::span<const u8> m_bytes;
+            DecodedInstruction<T> m_instruction = { };
+        };
+
+        constexpr explicit LinearSweep(std::span<const u8> bytes, u64 offset = 0x00) : m_bytes(bytes), m_offset(offset) { }
+
+        [[nodiscard]] Iterator begin() const { return { this->m_bytes, this->m_offset }; }
+        [[nodiscard]] constexpr std::default_sentinel_t end() const { return { }; }
+
+    private:
+        std::span<const u8> m_bytes;
+        u64 m_offset;
+    };
+
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    LinearSweep<T, Decoder> sweep(std::span<const u8> bytes, u64 offset = 0x00) {
+        return LinearSweep<T, Decoder>(bytes, offset);
+    }
+
+}
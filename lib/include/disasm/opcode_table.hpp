@@ -0,0 +1,230 @@
+#pragma once
+
+#include <dc.hpp>
+#include <helpers/type_array.hpp>
+#include <helpers/utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <utility>
+
+namespace dc::disasm {
+
+    namespace {
+
+        struct LeadingBytePattern {
+            u8 mask, compareValue, byteCount;
+            bool onlyLeadingByteFixed;
+        };
+
+        /*
+         * Candidates are tested against the first eight bytes of the input, loaded as a single integer in the patterns' byte order.
+         * Their mask and compare values are shifted to line up with that window so each test is a plain mask and compare.
+         */
+        struct OpcodeCandidate {
+            u64 mask, compareValue;
+            u16 index;
+            u8 byteCount;
+        };
+
+        /*
+         * The per pattern builders live outside of OpcodeTable. As members they'd be instantiated once per instruction with
+         * the entire InstructionArray in their name, making compile time and memory grow quadratically with the instruction count.
+         */
+        template<typename Pattern>
+        consteval OpcodeCandidate getCandidate(u16 index) {
+            constexpr auto Shift = Pattern::getEndian() == std::endian::big ? (sizeof(u64) - Pattern::getByteCount()) * 8 : 0;
+
+            return { u64(Pattern::getBitMaskWord()) << Shift, u64(Pattern::getBitCompareValueWord()) << Shift, index, u8(Pattern::getByteCount()) };
+        }
+
+        template<typename Pattern>
+        consteval LeadingBytePattern getLeadingBytePattern() {
+            constexpr auto Mask = Pattern::getBitMask();
+
+            bool onlyLeadingByteFixed = true;
+            for (size_t i = 1; i < Mask.size(); i++)
+                onlyLeadingByteFixed = onlyLeadingByteFixed && Mask[i] == 0x00;
+
+            return { Mask[0], Pattern::getBitCompareValues()[0], u8(Pattern::getByteCount()), onlyLeadingByteFixed };
+        }
+
+    }
+
+    /*
+     * Dispatch table indexed by the byte holding the leading opcode bits of an instruction.
+     * Each of the 256 entries lists the instructions whose pattern can match that byte, in the order
+     * they appear in the InstructionArray. Looking up an instruction therefore only tests the few
+     * candidates sharing the leading byte instead of walking the entire instruction list.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    class OpcodeTable {
+    public:
+        constexpr static size_t NotFound = T::Size;
+
+        [[nodiscard]]
+        static size_t find(std::span<const u8> bytes) {
+            if (bytes.size() <= LeadingByteOffset)
+                return NotFound;
+
+            const u8 leadingByte = bytes[LeadingByteOffset];
+
+            if constexpr (IsDense) {
+                const auto &entry = DenseTable[leadingByte];
+                return bytes.size() >= entry.byteCount ? entry.index : NotFound;
+            }
+
+            const auto window = loadWindow(bytes);
+            for (u32 i = Table.offsets[leadingByte]; i < Table.offsets[leadingByte + 1]; i++) {
+                const auto &candidate = Table.candidates[i];
+                if ((window & candidate.mask) == candidate.compareValue && candidate.byteCount <= bytes.size())
+                    return candidate.index;
+            }
+
+            return NotFound;
+        }
+
+        [[nodiscard]]
+        constexpr static size_t getCandidateCount(u8 leadingByte) {
+            return Table.offsets[leadingByte + 1] - Table.offsets[leadingByte];
+        }
+
+        /* Cheap check that rules out bytes which can't possibly start any instruction */
+        [[nodiscard]]
+        constexpr static bool hasCandidates(std::span<const u8> bytes) {
+            return bytes.size() > LeadingByteOffset && getCandidateCount(bytes[LeadingByteOffset]) > 0;
+        }
+
+    private:
+        using Candidate = OpcodeCandidate;
+
+        constexpr static std::endian Endian = T::template Get<0>::Pattern::getEndian();
+
+        struct DenseEntry {
+            u16 index;
+            u8 byteCount;
+        };
+
+        [[nodiscard]]
+        static u64 loadWindow(std::span<const u8> bytes) {
+            u64 result = 0;
+            if (bytes.size() >= sizeof(u64)) [[likely]]
+                std::memcpy(&result, bytes.data(), sizeof(result));
+            else
+                std::memcpy(&result, bytes.data(), bytes.size());
+
+            return Endian == std::endian::native ? result : hlp::byteSwap(result);
+        }
+
+        template<typename ... Instrs>
+        consteval static auto getLeadingBytePatterns(const hlp::TypeArray<Instrs...> &) {
+            return std::array<LeadingBytePattern, T::Size> {
+                getLeadingBytePattern<typename Instrs::Pattern>()...
+            };
+        }
+
+        template<typename ... Instrs>
+        consteval static auto getLeadingByteOffsets(const hlp::TypeArray<Instrs...> &) {
+            return std::array<size_t, T::Size> { Instrs::Pattern::getLeadingByteOffset()... };
+        }
+
+        template<typename ... Instrs, size_t ... Is>
+        consteval static auto getCandidates(const hlp::TypeArray<Instrs...> &, std::index_sequence<Is...>) {
+            return std::array<Candidate, T::Size> { getCandidate<typename Instrs::Pattern>(Is)... };
+        }
+
+        template<typename ... Instrs>
+        consteval static bool isSameEndian(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getEndian() == Endian) && ...);
+        }
+
+        constexpr static auto Patterns = getLeadingBytePatterns(T{ });
+        constexpr static auto Candidates = getCandidates(T{ }, std::make_index_sequence<T::Size>());
+
+        consteval static size_t getEntryCount() {
+            size_t count = 0;
+            for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+                for (const auto &pattern : Patterns) {
+                    if ((byte & pattern.mask) == pattern.compareValue)
+                        count++;
+                }
+            }
+
+            return count;
+        }
+
+        consteval static auto generateTable() {
+            struct {
+                std::array<u32, 257> offsets;
+                std::array<Candidate, getEntryCount()> candidates;
+            } result = { };
+
+            u32 count = 0;
+            for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+                result.offsets[byte] = count;
+                for (u16 index = 0; index < Patterns.size(); index++) {
+                    if ((byte & Patterns[index].mask) == Patterns[index].compareValue)
+                        result.candidates[count++] = Candidates[index];
+                }
+            }
+            result.offsets[256] = count;
+
+            return result;
+        }
+
+        /*
+         * If no two instructions share a leading byte and no instruction has fixed bits outside of it, the leading byte
+         * alone identifies the instruction. In that case a single lookup replaces walking the candidates.
+         */
+        consteval static bool isDense() {
+            for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+                size_t count = 0;
+                for (const auto &pattern : Patterns) {
+                    if ((byte & pattern.mask) == pattern.compareValue) {
+                        if (!pattern.onlyLeadingByteFixed)
+                            return false;
+
+                        count++;
+                    }
+                }
+
+                if (count > 1)
+                    return false;
+            }
+
+            return true;
+        }
+
+        consteval static auto generateDenseTable() {
+            std::array<DenseEntry, 256> result = { };
+
+            for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+                result[byte] = { u16(NotFound), 0 };
+                for (u16 index = 0; index < Patterns.size(); index++) {
+                    if ((byte & Patterns[index].mask) == Patterns[index].compareValue)
+                        result[byte] = { index, Patterns[index].byteCount };
+                }
+            }
+
+            return result;
+        }
+
+        constexpr static auto LeadingByteOffsets = getLeadingByteOffsets(T{ });
+        constexpr static size_t LeadingByteOffset = LeadingByteOffsets[0];
+
+        static_assert(T::Size <= std::numeric_limits<u16>::max(), "Too many instructions for opcode table");
+        static_assert(isSameEndian(T{ }), "Opcode table decoding requires all instructions to have the same endianness");
+        static_assert(std::all_of(LeadingByteOffsets.begin(), LeadingByteOffsets.end(), [](size_t offset) { return offset == LeadingByteOffset; }),
+                      "All instructions need to have their leading opcode bits at the same byte offset!");
+
+        constexpr static auto Table = generateTable();
+        constexpr static bool IsDense = isDense();
+        constexpr static auto DenseTable = generateDenseTable();
+    };
+
+}
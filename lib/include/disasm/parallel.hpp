@@ -0,0 +1,226 @@
+#pragma once
+
+#include <disasm/architecture.hpp>
+#include <disasm/decode.hpp>
+#include <disasm/disassembler.hpp>
+#include <helpers/thread_pool.hpp>
+
+#include <algorithm>
+#include <future>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace dc::disasm {
+
+    namespace {
+
+        template<ArchitectureType T, typename ... Instrs>
+        consteval bool isFixedWidth(const hlp::TypeArray<Instrs...> &) {
+            return ((Instrs::Pattern::getByteCount() == T::InstructionSizeMin) && ...);
+        }
+
+        template<ArchitectureType T>
+        constexpr bool IsFixedWidth = isFixedWidth<T>(typename T::Instructions{ });
+
+        /* Chunks smaller than this aren't worth handing off to another thread */
+        constexpr size_t MinChunkSize = 64 * 1024;
+
+        template<ArchitectureType T>
+        size_t getChunkSize(size_t byteCount, const hlp::ThreadPool &pool) {
+            // Hand out a few chunks per thread so threads finishing early can pick up more work
+            const auto chunkSize = std::max(MinChunkSize, byteCount / (pool.getThreadCount() * 4));
+
+            return (chunkSize + T::InstructionSizeMin - 1) / T::InstructionSizeMin * T::InstructionSizeMin;
+        }
+
+        template<ArchitectureType T, template<typename> typename Decoder>
+        std::vector<DecodedInstruction<T>> decodeRange(std::span<const u8> bytes, u64 begin, u64 end) {
+            std::vector<DecodedInstruction<T>> instructions;
+            instructions.reserve((end - begin) / T::InstructionSizeMin);
+
+            // Limit the span to the end of the range so data runs stop at the chunk boundary
+            const auto rangeBytes = bytes.first(end);
+
+            u64 offset = begin;
+            while (offset < end) {
+                const auto &instruction = instructions.emplace_back(decodeNext<T, Decoder>(offset, rangeBytes));
+                offset += instruction.length;
+            }
+
+            return instructions;
+        }
+
+        /*
+         * Decodes a chunk of a variable width instruction set starting at its first byte, without knowing whether that's
+         * actually an instruction boundary. Instructions are recorded one decoding step at a time until the chunk's end is reached.
+         */
+        template<ArchitectureType T, template<typename> typename Decoder>
+        std::vector<DecodedInstruction<T>> decodeSpeculatively(std::span<const u8> bytes, u64 begin, u64 end) {
+            std::vector<DecodedInstruction<T>> instructions;
+            instructions.reserve((end - begin) / T::InstructionSizeMin);
+
+            u64 offset = begin;
+            while (offset < end) {
+                const auto &instruction = instructions.emplace_back(dc::disasm::decodeInstruction<T, Decoder>(offset, bytes));
+                offset += instruction.length;
+            }
+
+            return instructions;
+        }
+
+        /*
+         * Rebuilds the data records the way decodeNext merges them when sweeping serially. Every stretch of consecutive data records,
+         * which may have been cut into pieces at chunk boundaries, is merged again from its start. Merging depends on the bytes
+         * of the whole stretch, so this can't be done by just joining neighbouring records.
+         */
+        template<ArchitectureType T, template<typename> typename Decoder>
+        std::vector<DecodedInstruction<T>> mergeDataRecords(const std::vector<DecodedInstruction<T>> &instructions, std::span<const u8> bytes) {
+            std::vector<DecodedInstruction<T>> result;
+            result.reserve(instructions.size());
+
+            size_t index = 0;
+            while (index < instructions.size()) {
+                if (instructions[index].isValid()) {
+                    result.push_back(instructions[index]);
+                    index++;
+                    continue;
+                }
+
+                const auto begin = instructions[index].offset;
+                while (index < instructions.size() && !instructions[index].isValid())
+                    index++;
+
+                const auto &last = instructions[index - 1];
+                const auto stretchBytes = bytes.first(last.offset + last.length);
+
+                u64 offset = begin;
+                while (offset < stretchBytes.size()) {
+                    const auto &instruction = result.emplace_back(decodeNext<T, Decoder>(offset, stretchBytes));
+                    offset += instruction.length;
+                }
+            }
+
+            return result;
+        }
+
+        template<ArchitectureType T, template<typename> typename Decoder>
+        std::vector<DecodedInstruction<T>> decodeFixedWidth(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+            const auto chunkSize = getChunkSize<T>(bytes.size(), pool);
+
+            std::vector<std::future<std::vector<DecodedInstruction<T>>>> chunks;
+            for (u64 begin = 0x00; begin < bytes.size(); begin += chunkSize) {
+                const auto end = std::min<u64>(begin + chunkSize, bytes.size());
+                chunks.push_back(pool.submit([bytes, begin, end] { return decodeRange<T, Decoder>(bytes, begin, end); }));
+            }
+
+            std::vector<DecodedInstruction<T>> instructions;
+            instructions.reserve(bytes.size() / T::InstructionSizeMin);
+            for (auto &chunk : chunks) {
+                const auto chunkInstructions = chunk.get();
+                instructions.insert(instructions.end(), chunkInstructions.begin(), chunkInstructions.end());
+            }
+
+            return mergeDataRecords<T, Decoder>(instructions, bytes);
+        }
+
+        /*
+         * Every chunk gets decoded speculatively from its first byte. The chunks are then stitched together in order:
+         * the instruction boundary at which the previous chunk's instructions end is looked up in the next chunk's
+         * boundaries. If it's not one of them, the decoder started in the middle of an instruction and instructions are
+         * decoded serially from the real boundary until the two sequences line up again, which usually only takes a few
+         * instructions. Everything from there on is taken over from the speculative decode.
+         */
+        template<ArchitectureType T, template<typename> typename Decoder>
+        std::vector<DecodedInstruction<T>> decodeVariableWidth(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+            const auto chunkSize = getChunkSize<T>(bytes.size(), pool);
+
+            std::vector<std::future<std::vector<DecodedInstruction<T>>>> chunks;
+            for (u64 begin = 0x00; begin < bytes.size(); begin += chunkSize) {
+                const auto end = std::min<u64>(begin + chunkSize, bytes.size());
+                chunks.push_back(pool.submit([bytes, begin, end] { return decodeSpeculatively<T, Decoder>(bytes, begin, end); }));
+            }
+
+            std::vector<DecodedInstruction<T>> instructions;
+            instructions.reserve(bytes.size() / T::InstructionSizeMin);
+
+            u64 offset = 0x00;
+            for (auto &chunk : chunks) {
+                const auto speculative = chunk.get();
+
+                auto it = speculative.begin();
+                while (it != speculative.end()) {
+                    while (it != speculative.end() && it->offset < offset)
+                        ++it;
+
+                    if (it == speculative.end() || it->offset == offset)
+                        break;
+
+                    const auto &instruction = instructions.emplace_back(dc::disasm::decodeInstruction<T, Decoder>(offset, bytes));
+                    offset += instruction.length;
+                }
+
+                for (; it != speculative.end(); ++it) {
+                    instructions.push_back(*it);
+                    offset = it->offset + it->length;
+                }
+            }
+
+            // The last chunk may have never lined up with the real instruction boundaries
+            while (offset < bytes.size()) {
+                const auto &instruction = instructions.emplace_back(dc::disasm::decodeInstruction<T, Decoder>(offset, bytes));
+                offset += instruction.length;
+            }
+
+            return mergeDataRecords<T, Decoder>(instructions, bytes);
+        }
+
+    }
+
+    /*
+     * Decodes the bytes on all threads of the pool. The result is identical to the one of the serial decode.
+     *
+     * Fixed width instructions all start on a multiple of the instruction size, so the input can be split at any
+     * aligned offset and the chunks decoded independently. Variable width instruction sets get decoded speculatively
+     * and are resynchronized at the chunk boundaries.
+     */
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    std::vector<DecodedInstruction<T>> decode(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+        if constexpr (IsFixedWidth<T>)
+            return decodeFixedWidth<T, Decoder>(bytes, pool);
+        else
+            return decodeVariableWidth<T, Decoder>(bytes, pool);
+    }
+
+    /*
+     * Parallel version of disassemble. Decoding and formatting both happen on the pool, the lines
+     * are returned in address order.
+     */
+    template<ArchitectureType T, template<typename> typename Decoder = OpcodeTable>
+    std::vector<std::string> disassemble(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+        const auto instructions = decode<T, Decoder>(bytes, pool);
+
+        std::vector<std::string> disassembly(instructions.size());
+
+        const auto chunkSize = std::max<size_t>(1, getChunkSize<T>(bytes.size(), pool) / T::InstructionSizeMin);
+
+        std::vector<std::future<void>> chunks;
+        for (size_t begin = 0; begin < instructions.size(); begin += chunkSize) {
+            const auto end = std::min(begin + chunkSize, instructions.size());
+            chunks.push_back(pool.submit([&, begin, end] {
+                InstructionBuffer buffer;
+                for (size_t i = begin; i < end; i++) {
+                    buffer.clear();
+                    disassembleInstruction<T>(buffer, instructions[i], bytes);
+                    disassembly[i].assign(buffer.data(), buffer.size());
+                }
+            }));
+        }
+
+        for (auto &chunk : chunks)
+            chunk.get();
+
+        return disassembly;
+    }
+
+}
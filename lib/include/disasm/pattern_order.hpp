@@ -0,0 +1,292 @@
+#pragma once
+
+#include <dc.hpp>
+#include <disasm/instruction.hpp>
+#include <helpers/type_array.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dc::disasm {
+
+    namespace {
+
+        /* Mask and compare values in the order the bytes appear in memory so patterns of different sizes can be compared */
+        struct OrderPatternInfo {
+            std::array<u8, sizeof(u64)> mask, compareValue;
+            size_t byteCount, fixedBitCount;
+            i32 priority;
+        };
+
+        template<typename Instr>
+        consteval i32 getPriority() {
+            if constexpr (requires { Instr::Priority; })
+                return Instr::Priority;
+            else
+                return 0;
+        }
+
+        /* Outside of PatternOrder so instantiating it for every instruction doesn't repeat the entire InstructionArray in each name */
+        template<typename Instr>
+        consteval OrderPatternInfo getPatternInfo() {
+            using Pattern = typename Instr::Pattern;
+            constexpr auto Size = Pattern::getByteCount();
+
+            OrderPatternInfo result = { };
+            result.byteCount = Size;
+            result.priority = getPriority<Instr>();
+
+            const auto mask = Pattern::getBitMask();
+            const auto compareValues = Pattern::getBitCompareValues();
+            for (size_t i = 0; i < Size; i++) {
+                const auto patternByte = Pattern::getEndian() == std::endian::little ? (Size - 1) - i : i;
+
+                result.mask[i] = mask[patternByte];
+                result.compareValue[i] = compareValues[patternByte];
+                result.fixedBitCount += std::popcount(mask[patternByte]);
+            }
+
+            return result;
+        }
+
+    }
+
+    /*
+     * Match order of the patterns in an InstructionArray, derived from the patterns themselves instead of the
+     * order they were written down in.
+     *
+     * Two patterns overlap if there are bytes matching both of them. Whenever that's the case, the more specific
+     * pattern, the one whose fixed bits are a superset of the other's, has to be tested first, otherwise it could
+     * never match. Patterns that overlap without either of them being more specific are ambiguous. An instruction
+     * can settle such a case by declaring a higher Priority than the other one, everything else is rejected at compile time.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    class PatternOrder {
+    public:
+        /* Whether some bytes match both the instruction at index a and the one at index b */
+        [[nodiscard]]
+        constexpr static bool overlaps(size_t a, size_t b) {
+            return a != b && isOverlapping(Patterns[a], Patterns[b]);
+        }
+
+        /* Whether the instruction at index a needs to be tested before the one at index b */
+        [[nodiscard]]
+        constexpr static bool mustPrecede(size_t a, size_t b) {
+            if (!overlaps(a, b))
+                return false;
+
+            if (Patterns[a].priority != Patterns[b].priority)
+                return Patterns[a].priority > Patterns[b].priority;
+            else
+                return isMoreSpecific(Patterns[a], Patterns[b]);
+        }
+
+        /* Whether testing the instructions in the given order of indices decodes every input the same way as Order does */
+        [[nodiscard]]
+        constexpr static bool isValidOrder(std::span<const size_t> order) {
+            if (order.size() != T::Size)
+                return false;
+
+            std::array<size_t, T::Size> positions = { };
+            positions.fill(T::Size);
+            for (size_t position = 0; position < order.size(); position++) {
+                if (order[position] >= T::Size || positions[order[position]] != T::Size)
+                    return false;
+
+                positions[order[position]] = position;
+            }
+
+            for (size_t a = 0; a < T::Size; a++) {
+                for (size_t b = 0; b < T::Size; b++) {
+                    if (positions[a] > positions[b] && mustPrecede(a, b))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        /*
+         * Instruction indices in match order. Patterns with a higher Priority come first, then patterns with more fixed bits,
+         * then longer patterns. Patterns equal in all of these keep their InstructionArray order.
+         */
+        [[nodiscard]]
+        constexpr static const auto& getOrder() {
+            return Order;
+        }
+
+    private:
+        using PatternInfo = OrderPatternInfo;
+
+        /* Number of bit positions isUnambiguous sorts the patterns by before comparing them pairwise */
+        constexpr static size_t BucketBitCount = 8;
+
+        template<typename ... Instrs>
+        consteval static auto getPatternInfos(const hlp::TypeArray<Instrs...> &) {
+            return std::array<PatternInfo, T::Size> { getPatternInfo<Instrs>()... };
+        }
+
+        /*
+         * Patterns of different sizes are compared over the bytes both of them cover. Bytes only covered by the
+         * longer pattern can still hold anything as far as the shorter one is concerned.
+         */
+        constexpr static bool isOverlapping(const PatternInfo &a, const PatternInfo &b) {
+            for (size_t i = 0; i < std::min(a.byteCount, b.byteCount); i++) {
+                if (((a.compareValue[i] ^ b.compareValue[i]) & a.mask[i] & b.mask[i]) != 0x00)
+                    return false;
+            }
+
+            return true;
+        }
+
+        /* Whether every input matching a also matches b, but not the other way around */
+        constexpr static bool isMoreSpecific(const PatternInfo &a, const PatternInfo &b) {
+            if (a.byteCount < b.byteCount)
+                return false;
+
+            bool hasMoreFixedBits = a.byteCount > b.byteCount;
+            for (size_t i = 0; i < b.byteCount; i++) {
+                if ((a.mask[i] & b.mask[i]) != b.mask[i])
+                    return false;
+
+                if (a.mask[i] != b.mask[i])
+                    hasMoreFixedBits = true;
+            }
+
+            return hasMoreFixedBits;
+        }
+
+        /*
+         * A more specific pattern always has more fixed bits or, with the same fixed bits, more bytes than the pattern it
+         * has to precede, so sorting by these keys satisfies every mustPrecede constraint without checking the pairs.
+         */
+        consteval static auto generateOrder() {
+            std::array<size_t, T::Size> result = { };
+            for (size_t index = 0; index < T::Size; index++)
+                result[index] = index;
+
+            std::sort(result.begin(), result.end(), [](size_t a, size_t b) {
+                const auto &lhs = Patterns[a], &rhs = Patterns[b];
+
+                if (lhs.priority != rhs.priority)
+                    return lhs.priority > rhs.priority;
+                if (lhs.fixedBitCount != rhs.fixedBitCount)
+                    return lhs.fixedBitCount > rhs.fixedBitCount;
+                if (lhs.byteCount != rhs.byteCount)
+                    return lhs.byteCount > rhs.byteCount;
+
+                return a < b;
+            });
+
+            return result;
+        }
+
+        /*
+         * Overlapping patterns agree on every bit both of them fix. Patterns are put into buckets by the bits at the positions
+         * fixed in the most patterns, a pattern leaving some of those bits open goes into every bucket it could match.
+         * Only patterns sharing a bucket can overlap, which keeps this from comparing every pair of a large instruction set.
+         */
+        consteval static bool isUnambiguous() {
+            size_t commonByteCount = sizeof(u64);
+            for (const auto &pattern : Patterns)
+                commonByteCount = std::min(commonByteCount, pattern.byteCount);
+
+            std::vector<size_t> bitPositions(commonByteCount * 8);
+            for (size_t position = 0; position < bitPositions.size(); position++)
+                bitPositions[position] = position;
+
+            const auto getFixedCount = [](size_t position) {
+                size_t result = 0;
+                for (const auto &pattern : Patterns)
+                    result += (pattern.mask[position / 8] >> (position % 8)) & 1;
+
+                return result;
+            };
+
+            std::vector<size_t> fixedCounts(bitPositions.size());
+            for (size_t position = 0; position < bitPositions.size(); position++)
+                fixedCounts[position] = getFixedCount(position);
+
+            std::sort(bitPositions.begin(), bitPositions.end(), [&](size_t a, size_t b) {
+                return fixedCounts[a] != fixedCounts[b] ? fixedCounts[a] > fixedCounts[b] : a < b;
+            });
+            bitPositions.resize(std::min(bitPositions.size(), BucketBitCount));
+
+            std::vector<std::vector<size_t>> buckets(size_t(1) << bitPositions.size());
+            for (size_t index = 0; index < T::Size; index++) {
+                size_t fixedKey = 0, openBits = 0;
+                for (size_t bit = 0; bit < bitPositions.size(); bit++) {
+                    const auto byte = bitPositions[bit] / 8, shift = bitPositions[bit] % 8;
+
+                    if ((Patterns[index].mask[byte] >> shift) & 1)
+                        fixedKey |= size_t((Patterns[index].compareValue[byte] >> shift) & 1) << bit;
+                    else
+                        openBits |= size_t(1) << bit;
+                }
+
+                for (size_t key = openBits; ; key = (key - 1) & openBits) {
+                    buckets[fixedKey | key].push_back(index);
+
+                    if (key == 0)
+                        break;
+                }
+            }
+
+            for (const auto &bucket : buckets) {
+                for (size_t a = 0; a < bucket.size(); a++) {
+                    for (size_t b = a + 1; b < bucket.size(); b++) {
+                        if (overlaps(bucket[a], bucket[b]) && !mustPrecede(bucket[a], bucket[b]) && !mustPrecede(bucket[b], bucket[a]))
+                            return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        /*
+         * A higher priority instruction that's a generalization of another one would make the other one unreachable.
+         * Only pairs with different priorities can contradict specificity and those always involve a non-default priority.
+         */
+        consteval static bool arePrioritiesConsistent() {
+            for (size_t a = 0; a < T::Size; a++) {
+                if (Patterns[a].priority == 0)
+                    continue;
+
+                for (size_t b = 0; b < T::Size; b++) {
+                    if (mustPrecede(a, b) && isMoreSpecific(Patterns[b], Patterns[a]))
+                        return false;
+                    if (mustPrecede(b, a) && isMoreSpecific(Patterns[a], Patterns[b]))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        constexpr static auto Patterns    = getPatternInfos(T{ });
+        constexpr static auto Order       = generateOrder();
+
+        static_assert(isUnambiguous(), "Instruction patterns overlap without either of them being more specific, give one of them a higher Priority");
+        static_assert(arePrioritiesConsistent(), "Instruction Priority makes a more specific instruction unreachable");
+    };
+
+    namespace {
+
+        template<typename T, size_t ... Is>
+        auto orderBySpecificity(std::index_sequence<Is...>) -> InstructionArray<typename T::template Get<PatternOrder<T>::getOrder()[Is]>...>;
+
+    }
+
+    /*
+     * The instructions of an InstructionArray reordered so that testing them one after another always finds the right one
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T>
+    using OrderBySpecificity = decltype(orderBySpecificity<T>(std::make_index_sequence<T::Size>()));
+
+}
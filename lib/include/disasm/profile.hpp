@@ -0,0 +1,139 @@
+#pragma once
+
+#include <dc.hpp>
+#include <disasm/architecture.hpp>
+#include <disasm/decode.hpp>
+#include <disasm/pattern_order.hpp>
+
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace dc::disasm {
+
+    /*
+     * Number of times each instruction of an architecture was decoded over a training corpus
+     */
+    template<ArchitectureType T>
+    class InstructionHistogram {
+    public:
+        constexpr static size_t Size = T::Instructions::Size;
+
+        void record(std::span<const DecodedInstruction<T>> instructions) {
+            for (const auto &instruction : instructions) {
+                if (instruction.isValid())
+                    this->m_counts[instruction.id]++;
+            }
+        }
+
+        template<template<typename> typename Decoder = OpcodeTable>
+        void record(std::span<const u8> bytes) {
+            this->record(decode<T, Decoder>(bytes));
+        }
+
+        [[nodiscard]] u64 getCount(size_t index) const { return this->m_counts[index]; }
+
+        [[nodiscard]] u64 getTotalCount() const {
+            u64 total = 0;
+            for (auto count : this->m_counts)
+                total += count;
+
+            return total;
+        }
+
+        /*
+         * Match order with the most frequent instructions first. Instructions are only moved ahead of others as far as
+         * the pattern overlap constraints allow, the order is always accepted by PatternOrder::isValidOrder.
+         */
+        [[nodiscard]] std::vector<size_t> getMatchOrder() const {
+            using Order = PatternOrder<typename T::Instructions>;
+
+            std::vector<size_t> result;
+            result.reserve(Size);
+
+            std::array<size_t, Size> predecessorCounts = { };
+            for (size_t a = 0; a < Size; a++) {
+                for (size_t b = 0; b < Size; b++)
+                    predecessorCounts[b] += Order::mustPrecede(a, b);
+            }
+
+            std::array<bool, Size> placed = { };
+            while (result.size() < Size) {
+                size_t next = Size;
+                for (size_t index = 0; index < Size; index++) {
+                    if (placed[index] || predecessorCounts[index] != 0)
+                        continue;
+
+                    if (next == Size || this->m_counts[index] > this->m_counts[next])
+                        next = index;
+                }
+
+                placed[next] = true;
+                result.push_back(next);
+                for (size_t b = 0; b < Size; b++)
+                    predecessorCounts[b] -= Order::mustPrecede(next, b);
+            }
+
+            return result;
+        }
+
+        /* Average number of patterns a linear decoder testing them in the given order needs to test per recorded instruction */
+        [[nodiscard]] double getAverageMatchCount(std::span<const size_t> order) const {
+            const auto total = this->getTotalCount();
+            if (total == 0)
+                return 0;
+
+            u64 matches = 0;
+            for (size_t position = 0; position < order.size(); position++)
+                matches += this->m_counts[order[position]] * (position + 1);
+
+            return double(matches) / double(total);
+        }
+
+    private:
+        std::array<u64, Size> m_counts = { };
+    };
+
+    /*
+     * Writes a header declaring the histogram's match order as MatchOrder in namespace dc::disasm::profiled::<orderNamespace>,
+     * along with a Decoder alias of ProfiledDecoder testing the instructions in that order. instructionsType is the fully
+     * qualified name of the architecture's Instructions type and architectureHeader the header declaring it.
+     */
+    template<ArchitectureType T>
+    std::string generateOrderHeader(const InstructionHistogram<T> &histogram, std::string_view instructionsType, std::string_view architectureHeader, std::string_view orderNamespace) {
+        const auto order = histogram.getMatchOrder();
+        const auto total = histogram.getTotalCount();
+
+        fmt::memory_buffer buffer;
+        auto out = fmt::appender(buffer);
+
+        fmt::format_to(out, "#pragma once\n\n");
+        fmt::format_to(out, "/* Generated from a histogram of {} instructions, {:.2f} patterns tested per instruction on average */\n\n", total, histogram.getAverageMatchCount(order));
+        fmt::format_to(out, "#include <{}>\n#include <disasm/profiled_decoder.hpp>\n\n#include <array>\n\n", architectureHeader);
+        fmt::format_to(out, "namespace dc::disasm::profiled::{} {{\n\n", orderNamespace);
+        fmt::format_to(out, "    static_assert({}::Size == {}, \"Instruction set changed, regenerate the order header\");\n\n", instructionsType, order.size());
+        fmt::format_to(out, "    inline constexpr std::array<size_t, {}> MatchOrder = {{\n", order.size());
+
+        [&]<typename ... Instrs>(const hlp::TypeArray<Instrs...> &) {
+            constexpr std::array<std::string_view, sizeof...(Instrs)> Mnemonics = { Instrs::Mnemonic... };
+
+            for (size_t position = 0; position < order.size(); position++) {
+                const auto index = order[position];
+                const auto count = histogram.getCount(index);
+
+                fmt::format_to(out, "        {:>4},  // {:<8} {:>10} ({:.2f}%)\n", index, Mnemonics[index], count, total == 0 ? 0.0 : count * 100.0 / total);
+            }
+        }(typename T::Instructions{ });
+
+        fmt::format_to(out, "    }};\n\n");
+        fmt::format_to(out, "    template<typename T>\n    using Decoder = ProfiledDecoder<T, MatchOrder>;\n\n}}\n");
+
+        return fmt::to_string(buffer);
+    }
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <dc.hpp>
+#include <disasm/pattern_order.hpp>
+#include <helpers/type_array.hpp>
+
+#include <concepts>
+#include <span>
+#include <utility>
+
+namespace dc::disasm {
+
+    /*
+     * Linear decoder testing the patterns in the given order of instruction indices. With the most frequent instructions
+     * of the code being decoded at the front, most lookups only need to test a handful of patterns.
+     *
+     * Without an explicit order the specificity order is used. Order headers written by generateOrderHeader declare
+     * the order of a recorded histogram together with a Decoder alias passing it here.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T, const auto &Order = PatternOrder<T>::getOrder()>
+    class ProfiledDecoder {
+    public:
+        constexpr static size_t NotFound = T::Size;
+
+        [[nodiscard]]
+        static size_t find(std::span<const u8> bytes) {
+            return [&]<size_t ... Positions>(std::index_sequence<Positions...>) {
+                size_t result = NotFound;
+                (void)((T::template Get<Order[Positions]>::Pattern::matches(bytes) && (result = Order[Positions], true)) || ...);
+
+                return result;
+            }(std::make_index_sequence<T::Size>());
+        }
+
+    private:
+        static_assert(PatternOrder<T>::isValidOrder(Order), "Match order violates pattern overlap constraints, regenerate the order header");
+    };
+
+}
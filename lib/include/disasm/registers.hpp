@@ -0,0 +1,77 @@
+#pragma once
+
+#include <dc.hpp>
+#include <ast/ast_node.hpp>
+#include <disasm/architecture.hpp>
+
+#include <array>
+#include <bitset>
+#include <stdexcept>
+#include <string_view>
+
+namespace dc::disasm {
+
+    /*
+     * Short register or flag name that can be assembled in constant expressions
+     */
+    class RegisterName {
+    public:
+        constexpr RegisterName() = default;
+        constexpr RegisterName(const char *name) { this->append(name); }
+
+        constexpr RegisterName& append(std::string_view string) {
+            if (this->m_length + string.size() > this->m_chars.size())
+                throw std::length_error("Register name too long");
+
+            for (char c : string)
+                this->m_chars[this->m_length++] = c;
+
+            return *this;
+        }
+
+        constexpr RegisterName& appendDecimal(u32 value) {
+            std::array<char, 10> digits = { };
+
+            size_t count = 0;
+            do {
+                digits[count++] = char('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+
+            while (count > 0)
+                this->append(std::string_view(&digits[--count], 1));
+
+            return *this;
+        }
+
+        constexpr RegisterName& appendHex(u32 value, size_t digitCount) {
+            constexpr std::string_view Digits = "0123456789ABCDEF";
+
+            for (size_t i = digitCount; i > 0; i--)
+                this->append(Digits.substr((value >> ((i - 1) * 4)) & 0xF, 1));
+
+            return *this;
+        }
+
+        [[nodiscard]] constexpr std::string_view get() const { return { this->m_chars.data(), this->m_length }; }
+
+    private:
+        std::array<char, 15> m_chars = { };
+        u8 m_length = 0;
+    };
+
+    /*
+     * All registers or flags of an architecture. Lifted AST nodes only hold the index of a name in one of these tables,
+     * the name itself is looked up once the AST gets printed.
+     */
+    template<size_t Size>
+    using RegisterTable = std::array<RegisterName, Size>;
+
+    /* Sets of registers and flags of an architecture, e.g. the ones an instruction reads or writes */
+    template<ArchitectureType T>
+    using RegisterSet = std::bitset<T::Registers.size()>;
+
+    template<ArchitectureType T>
+    using FlagSet = std::bitset<T::Flags.size()>;
+
+}
@@ -5,10 +5,20 @@
 #include <helpers/utils.hpp>
 
 #include <array>
+#include <bit>
+#include <cstring>
 #include <numeric>
+#include <type_traits>
+
+#if defined(__BMI2__)
+    #include <immintrin.h>
+#endif
 
 namespace dc::hlp {
 
+    template<size_t Size>
+    using PatternWord = std::conditional_t<(Size <= sizeof(u32)), u32, u64>;
+
     template<StaticString Pattern, std::endian Endian>
     class BitPattern {
     public:
@@ -27,84 +37,46 @@ namespace dc::hlp {
 
         [[maybe_unused]]
         consteval static size_t getPlaceholderCount() {
-            std::array<bool, 256> placeholders = { };
+            u64 placeholders = 0;
 
             for (char c : Pattern) {
-                if (isLower(c) || isUpper(c))
-                    placeholders[c] = true;
+                if (isLower(c))
+                    placeholders |= u64(1) << (c - 'a');
+                else if (isUpper(c))
+                    placeholders |= u64(1) << (c - 'A' + 26);
             }
 
-            return std::accumulate(placeholders.begin(), placeholders.end(), 0);
+            return std::popcount(placeholders);
         }
 
-        consteval static size_t getBitCount() {
-            return std::count_if(Pattern.begin(), Pattern.end(), shouldConsiderCharacter);
-        }
-
-        consteval static size_t getByteCount() { return getBitCount() / 8; }
-
-        [[nodiscard]]
         [[maybe_unused]]
-        constexpr static bool matches(const auto &container) {
-            constexpr size_t Size = getByteCount();
-            constexpr auto BitMask = getBitMask();
-            constexpr auto CompareValues = getBitCompareValues();
-
-            if (container.size() < Size) return false;
-            if (sizeof(container[0]) != sizeof(u8)) return false;
-
-            for (u32 i = 0; i < Size; i++) {
-                if ((container[Endian == std::endian::little ? ((Size - 1) - i) : i] & BitMask[i]) != CompareValues[i])
-                    return false;
-            }
-
-            return true;
-        }
+        consteval static auto getPlaceholders() {
+            std::array<char, getPlaceholderCount()> result = { };
 
-        template<char Placeholder>
-        [[nodiscard]] [[maybe_unused]] constexpr static auto getPlaceholderValue(const auto &container) {
-            constexpr size_t Size = getByteCount();
-
-            static_assert(isLower(Placeholder) || isUpper(Placeholder), "Invalid placeholder");
-            static_assert(hasPlaceholder<Placeholder>(), "Placeholder not found in Pattern");
-
-            u64 result = 0x00;
-
-            u32 pos = 0;
+            size_t count = 0;
             for (char c : Pattern) {
-                if (c == Placeholder) {
-                    result <<= 1;
-                    result |= (container[Endian == std::endian::little ? ((Size - 1) - (pos / 8)) : pos / 8] & (0x80 >> (pos % 8))) != 0;
-                }
-
-                if (shouldConsiderCharacter(c))
-                    pos++;
+                if ((isLower(c) || isUpper(c)) && std::find(result.begin(), result.begin() + count, c) == result.begin() + count)
+                    result[count++] = c;
             }
 
             return result;
         }
 
-    private:
-        consteval static bool placeholdersValid() {
-            bool hasLowerCasePlaceholders = std::any_of(Pattern.begin(), Pattern.end(), isLower);
-            bool hasUpperCasePlaceholders = std::any_of(Pattern.begin(), Pattern.end(), isUpper);
-
-            return !(hasLowerCasePlaceholders && hasUpperCasePlaceholders);
+        /* Number of bits making up a placeholder's value */
+        template<char Placeholder>
+        consteval static size_t getPlaceholderBitCount() {
+            return std::count(Pattern.begin(), Pattern.end(), Placeholder);
         }
 
-        consteval static bool patternValid() {
-            return std::all_of(Pattern.begin(), Pattern.end(), [](char c) {
-                return
-                        c == '0'   || c == '1' ||
-                        c == '\''  || c == ' ' ||
-                        isLower(c) || isUpper(c) ||
-                        c == 0x00;
-            });
+        consteval static size_t getBitCount() {
+            return std::count_if(Pattern.begin(), Pattern.end(), shouldConsiderCharacter);
         }
 
-        constexpr static bool shouldConsiderCharacter(char c) {
-            return c == '0' || c == '1' || isLower(c) || isUpper(c);
-        }
+        consteval static size_t getByteCount() { return getBitCount() / 8; }
+
+        consteval static std::endian getEndian() { return Endian; }
+
+        consteval static size_t getLeadingByteOffset() { return Endian == std::endian::little ? getByteCount() - 1 : 0; }
 
         constexpr static auto getBitMask() {
             std::array<u8, getByteCount()> result = { };
@@ -142,9 +114,186 @@ namespace dc::hlp {
             return result;
         }
 
+        /*
+         * Bit mask and compare values as a single integer, the first pattern character being the most significant bit
+         */
+        consteval static auto getBitMaskWord() {
+            PatternWord<getByteCount()> result = 0;
+            for (auto byte : getBitMask())
+                result = (result << 8) | byte;
+
+            return result;
+        }
+
+        consteval static auto getBitCompareValueWord() {
+            PatternWord<getByteCount()> result = 0;
+            for (auto byte : getBitCompareValues())
+                result = (result << 8) | byte;
+
+            return result;
+        }
+
+        /*
+         * Loads the bytes covered by the pattern as one integer laid out like getBitMaskWord().
+         * The container needs to hold at least getByteCount() bytes.
+         */
+        [[nodiscard]]
+        constexpr static auto loadWord(const auto &container) {
+            using Word = PatternWord<getByteCount()>;
+            constexpr size_t Size = getByteCount();
+            static_assert(sizeof(container[0]) == sizeof(u8), "Patterns can only be matched against byte containers");
+
+            if (std::is_constant_evaluated()) {
+                Word result = 0;
+                for (u32 i = 0; i < Size; i++)
+                    result = (result << 8) | container[Endian == std::endian::little ? ((Size - 1) - i) : i];
+
+                return result;
+            }
+
+            constexpr size_t Shift = (sizeof(Word) - Size) * 8;
+
+            Word raw = 0;
+            std::memcpy(&raw, std::data(container), Size);
+
+            if constexpr (std::endian::native == std::endian::little)
+                return Endian == std::endian::little ? raw : Word(byteSwap(raw) >> Shift);
+            else
+                return Endian == std::endian::big ? Word(raw >> Shift) : byteSwap(raw);
+        }
+
+        [[nodiscard]]
+        [[maybe_unused]]
+        constexpr static bool matches(const auto &container) {
+            if (container.size() < getByteCount()) return false;
+
+            return (loadWord(container) & getBitMaskWord()) == getBitCompareValueWord();
+        }
+
+        /*
+         * Bits of the pattern word that belong to a placeholder
+         */
+        template<char Placeholder>
+        consteval static auto getPlaceholderMaskWord() {
+            PatternWord<getByteCount()> result = 0;
+            for (char c : Pattern) {
+                if (shouldConsiderCharacter(c))
+                    result = (result << 1) | (c == Placeholder);
+            }
+
+            return result;
+        }
+
+        template<char Placeholder>
+        [[nodiscard]] [[maybe_unused]] constexpr static auto getPlaceholderValue(const auto &container) {
+            static_assert(isLower(Placeholder) || isUpper(Placeholder), "Invalid placeholder");
+            static_assert(hasPlaceholder<Placeholder>(), "Placeholder not found in Pattern");
+
+            const auto word = loadWord(container);
+
+            #if defined(__BMI2__)
+                if (!std::is_constant_evaluated()) {
+                    if constexpr (sizeof(word) == sizeof(u32))
+                        return u64(_pext_u32(word, getPlaceholderMaskWord<Placeholder>()));
+                    else
+                        return u64(_pext_u64(word, getPlaceholderMaskWord<Placeholder>()));
+                }
+            #endif
+
+            constexpr auto Segments = getPlaceholderSegments<Placeholder>();
+
+            u64 result = 0x00;
+            for (const auto &segment : Segments)
+                result |= u64((word >> segment.shift) & segment.mask) << segment.resultShift;
+
+            return result;
+        }
+
+    private:
+        struct PlaceholderSegment {
+            u8 shift;
+            PatternWord<sizeof(u64)> mask;
+            u8 resultShift;
+        };
+
+        /*
+         * Splits the bits of a placeholder into runs of adjacent bits so its value can be assembled
+         * with one shift, mask and or per run instead of one per bit
+         */
+        template<char Placeholder>
+        consteval static size_t getPlaceholderSegmentCount() {
+            size_t count = 0;
+
+            bool previous = false;
+            for (char c : Pattern) {
+                if (!shouldConsiderCharacter(c))
+                    continue;
+
+                if (c == Placeholder && !previous)
+                    count++;
+
+                previous = c == Placeholder;
+            }
+
+            return count;
+        }
+
+        template<char Placeholder>
+        consteval static auto getPlaceholderSegments() {
+            std::array<PlaceholderSegment, getPlaceholderSegmentCount<Placeholder>()> result = { };
+
+            const auto placeholderBits = getPlaceholderBitCount<Placeholder>();
+
+            size_t bit = getBitCount(), resultBit = placeholderBits, segment = 0;
+            bool previous = false;
+            for (char c : Pattern) {
+                if (!shouldConsiderCharacter(c))
+                    continue;
+
+                bit--;
+
+                if (c == Placeholder) {
+                    resultBit--;
+
+                    if (!previous)
+                        result[segment++].mask = 0;
+
+                    auto &current = result[segment - 1];
+                    current.shift = bit;
+                    current.resultShift = resultBit;
+                    current.mask = (current.mask << 1) | 1;
+                }
+
+                previous = c == Placeholder;
+            }
+
+            return result;
+        }
+
+        consteval static bool placeholdersValid() {
+            bool hasLowerCasePlaceholders = std::any_of(Pattern.begin(), Pattern.end(), isLower);
+            bool hasUpperCasePlaceholders = std::any_of(Pattern.begin(), Pattern.end(), isUpper);
+
+            return !(hasLowerCasePlaceholders && hasUpperCasePlaceholders);
+        }
+
+        consteval static bool patternValid() {
+            for (char c : Pattern) {
+                if (!(shouldConsiderCharacter(c) || c == '\'' || c == ' ' || c == 0x00))
+                    return false;
+            }
+
+            return true;
+        }
+
+        constexpr static bool shouldConsiderCharacter(char c) {
+            return c == '0' || c == '1' || isLower(c) || isUpper(c);
+        }
+
         static_assert(placeholdersValid(), "Can't have both upper and lower case placeholder characters!");
         static_assert(patternValid(), "Invalid characters in pattern! Allowed are 0, 1, ', <space>, a-z and A-Z.");
         static_assert((getBitCount() % 8) == 0 && getBitCount() != 0, "Invalid pattern size. Pattern needs to consist of a multiple of 8 bits.");
+        static_assert(getByteCount() <= sizeof(u64), "Invalid pattern size. Patterns can be at most 64 bits long.");
     };
 
 }
\ No newline at end of file
@@ -26,6 +26,16 @@ namespace dc::hlp {
             return this->data + size();
         }
 
+        template<size_t M>
+        [[nodiscard]]
+        constexpr StaticString<N + M - 1> operator+(const StaticString<M> &other) const {
+            char result[N + M - 1] = { };
+            std::copy_n(this->data, size(), result);
+            std::copy_n(other.data, M, result + size());
+
+            return result;
+        }
+
         char data[N];
     };
 
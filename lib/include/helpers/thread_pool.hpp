@@ -0,0 +1,91 @@
+#pragma once
+
+#include <dc.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dc::hlp {
+
+    /*
+     * Fixed set of worker threads executing submitted tasks in submission order.
+     * Results are handed back through futures so callers can collect them in whatever order they need.
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency()) {
+            threadCount = std::max<size_t>(threadCount, 1);
+
+            this->m_workers.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; i++)
+                this->m_workers.emplace_back([this] { this->work(); });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::scoped_lock lock(this->m_mutex);
+                this->m_stopping = true;
+            }
+
+            this->m_condition.notify_all();
+            for (auto &worker : this->m_workers)
+                worker.join();
+        }
+
+        template<typename F>
+        [[nodiscard]] auto submit(F &&function) -> std::future<std::invoke_result_t<F>> {
+            auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(function));
+            auto future = task->get_future();
+
+            {
+                std::scoped_lock lock(this->m_mutex);
+                this->m_tasks.emplace([task] { (*task)(); });
+            }
+
+            this->m_condition.notify_one();
+
+            return future;
+        }
+
+        [[nodiscard]] size_t getThreadCount() const { return this->m_workers.size(); }
+
+    private:
+        void work() {
+            while (true) {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock lock(this->m_mutex);
+                    this->m_condition.wait(lock, [this] { return this->m_stopping || !this->m_tasks.empty(); });
+
+                    if (this->m_tasks.empty())
+                        return;
+
+                    task = std::move(this->m_tasks.front());
+                    this->m_tasks.pop();
+                }
+
+                task();
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::queue<std::function<void()>> m_tasks;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping = false;
+    };
+
+}
@@ -1,19 +1,53 @@
 #pragma once
 
-#include <tuple>
+#include <cstddef>
+#include <utility>
 
 namespace dc::hlp {
 
     struct TypeArrayBase {};
 
+    #if defined(__has_builtin)
+        #if __has_builtin(__type_pack_element)
+            #define DC_HAS_TYPE_PACK_ELEMENT
+        #endif
+    #endif
+
+    namespace {
+
+        template<size_t Index, typename T>
+        struct IndexedType {
+            using Type = T;
+        };
+
+        template<typename Indices, typename ... Ts>
+        struct IndexedTypes;
+
+        template<size_t ... Is, typename ... Ts>
+        struct IndexedTypes<std::index_sequence<Is...>, Ts...> : IndexedType<Is, Ts>... {};
+
+        /* Overload resolution picks the only base class with a matching index, no matter how many types there are */
+        template<size_t Index, typename T>
+        IndexedType<Index, T> selectType(const IndexedType<Index, T> &);
+
+    }
+
     template<typename ... Ts>
     struct TypeArray : public TypeArrayBase {
-        using Types = std::tuple<Ts...>;
-
-        template<size_t Index>
-        using Get = std::tuple_element_t<Index, Types>;
+        /*
+         * Looking up a type by index needs to be a single step rather than recursing through all types before it,
+         * otherwise compile times grow quadratically with the number of types. Without __type_pack_element that step
+         * still searches all types, so code going over every type deduces them from a TypeArray<Ts...> parameter instead.
+         */
+        #if defined(DC_HAS_TYPE_PACK_ELEMENT)
+            template<size_t Index>
+            using Get = __type_pack_element<Index, Ts...>;
+        #else
+            template<size_t Index>
+            using Get = typename decltype(selectType<Index>(IndexedTypes<std::index_sequence_for<Ts...>, Ts...>{ }))::Type;
+        #endif
 
         constexpr static size_t Size = sizeof...(Ts);
     };
 
-}
\ No newline at end of file
+}
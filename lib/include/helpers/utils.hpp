@@ -2,7 +2,10 @@
 
 #include <dc.hpp>
 
-#include <string>
+#include <bit>
+#include <concepts>
+#include <string_view>
+#include <utility>
 
 namespace dc::hlp {
 
@@ -16,11 +19,24 @@ namespace dc::hlp {
         return c >= 'A' && c <= 'Z';
     }
 
+    template<std::unsigned_integral T>
+    [[nodiscard]]
+    constexpr T byteSwap(T value) {
+        #if defined(__cpp_lib_byteswap)
+            return std::byteswap(value);
+        #else
+            /* Written as one expression so compilers can recognize it and emit a single byte swap instruction */
+            return [value]<size_t ... Is>(std::index_sequence<Is...>) {
+                return T(((T(T(value >> (Is * 8)) & 0xFF) << ((sizeof(T) - 1 - Is) * 8)) | ...));
+            }(std::make_index_sequence<sizeof(T)>());
+        #endif
+    }
+
     struct Empty { };
 
-    inline std::string trim(const std::string &string) {
+    inline std::string_view trim(std::string_view string) {
         auto first = string.find_first_not_of(' ');
-        if (first == std::string::npos)
+        if (first == std::string_view::npos)
             return "";
 
         auto last = string.find_last_not_of(' ');
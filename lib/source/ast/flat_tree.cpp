@@ -0,0 +1,117 @@
+#include <ast/flat_tree.hpp>
+
+#include <decomp/decompiler.hpp>
+
+namespace dc::ast {
+
+    namespace {
+
+        class Flattener final : public dc::decomp::Visitor {
+        public:
+            explicit Flattener(FlatTree &tree) : m_tree(tree) { }
+
+            NodeRef flatten(ASTNode &node) {
+                dispatch(node, [this](auto &concreteNode) { this->visit(concreteNode); });
+                return this->m_result;
+            }
+
+            void visit(ASTNodeIntegerLiteral &node) override {
+                this->m_result = this->m_tree.addIntegerLiteral(node.getValue());
+            }
+
+            void visit(ASTNodeJump &node) override {
+                this->m_result = this->m_tree.addJump(this->flatten(*node.getDestination()));
+            }
+
+            void visit(ASTNodeBinaryArithmetic &node) override {
+                const auto lhs = this->flatten(*node.getLeftHandSide());
+                const auto rhs = this->flatten(*node.getRightHandSide());
+
+                this->m_result = this->m_tree.addBinaryArithmetic(lhs, rhs, node.getOperator());
+            }
+
+            void visit(ASTNodeRegister &node) override {
+                this->m_result = this->m_tree.addRegister(node.getRegisterId());
+            }
+
+            void visit(ASTNodeAssignment &node) override {
+                const auto source = this->flatten(*node.getSource());
+                const auto destination = this->flatten(*node.getDestination());
+
+                this->m_result = this->m_tree.addAssignment(source, destination);
+            }
+
+            void visit(ASTNodeUnaryArithmetic &node) override {
+                this->m_result = this->m_tree.addUnaryArithmetic(this->flatten(*node.getOperand()), node.getOperator());
+            }
+
+            void visit(ASTNodeFlag &node) override {
+                this->m_result = this->m_tree.addFlag(node.getFlagId());
+            }
+
+            void visit(ASTNodeConditional &node) override {
+                const auto condition = this->flatten(*node.getCondition());
+                const auto trueBlock = this->flattenBlock(node.getTrueBlock());
+                const auto falseBlock = this->flattenBlock(node.getFalseBlock());
+
+                this->m_result = this->m_tree.addConditional(condition, trueBlock, falseBlock);
+            }
+
+            void visit(ASTNodeControlFlowStatement &node) override {
+                this->m_result = this->m_tree.addControlFlowStatement(node.getType());
+            }
+
+            void visit(ASTNodeAssembly &node) override {
+                this->m_result = this->m_tree.addAssembly(node.getAssembly());
+            }
+
+            void visit(ASTNodeFunctionCall &node) override {
+                this->m_result = this->m_tree.addFunctionCall(this->flatten(*node.getDestination()));
+            }
+
+        private:
+            std::vector<NodeRef> flattenBlock(const NodeList &block) {
+                std::vector<NodeRef> result;
+                result.reserve(block.size());
+
+                for (const auto &node : block)
+                    result.push_back(this->flatten(*node));
+
+                return result;
+            }
+
+            FlatTree &m_tree;
+            NodeRef m_result;
+        };
+
+    }
+
+    void FlatTree::clear() {
+        this->m_integerLiterals.clear();
+        this->m_registers.clear();
+        this->m_flags.clear();
+        this->m_jumps.clear();
+        this->m_functionCalls.clear();
+        this->m_assignments.clear();
+        this->m_unaryArithmetics.clear();
+        this->m_binaryArithmetics.clear();
+        this->m_conditionals.clear();
+        this->m_controlFlowStatements.clear();
+        this->m_assemblies.clear();
+
+        this->m_statements.clear();
+        this->m_blockNodes.clear();
+        this->m_stringData.clear();
+    }
+
+    FlatTree FlatTree::flatten(std::span<const NodePtr> nodes) {
+        FlatTree tree;
+        Flattener flattener(tree);
+
+        for (const auto &node : nodes)
+            tree.addStatement(flattener.flatten(*node));
+
+        return tree;
+    }
+
+}
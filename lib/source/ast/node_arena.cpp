@@ -0,0 +1,58 @@
+#include <ast/node_arena.hpp>
+
+namespace dc::ast {
+
+    namespace {
+
+        thread_local NodeArena *currentArena = nullptr;
+
+        constexpr size_t alignSize(size_t size) {
+            return (size + (NodeArena::Alignment - 1)) & ~(NodeArena::Alignment - 1);
+        }
+
+    }
+
+    void *NodeArena::allocate(size_t size) {
+        size = alignSize(size);
+        this->m_allocatedSize += size;
+
+        /* Oversized allocations get a block of their own so the rest of the current block can still be used */
+        if (size > this->m_blockSize)
+            return this->m_blocks.emplace_back(new std::byte[size]).get();
+
+        if (size_t(this->m_end - this->m_current) < size) {
+            this->m_current = this->m_blocks.emplace_back(new std::byte[this->m_blockSize]).get();
+            this->m_end = this->m_current + this->m_blockSize;
+        }
+
+        auto result = this->m_current;
+        this->m_current += size;
+
+        return result;
+    }
+
+    void NodeArena::reset() {
+        this->m_allocatedSize = 0;
+
+        if (this->m_blocks.empty())
+            return;
+
+        /* Every block is at least m_blockSize bytes large, so the first one can always be reused as a regular block */
+        this->m_blocks.resize(1);
+        this->m_current = this->m_blocks.front().get();
+        this->m_end = this->m_current + this->m_blockSize;
+    }
+
+    NodeArenaScope::NodeArenaScope(NodeArena &arena) : m_previousArena(currentArena) {
+        currentArena = &arena;
+    }
+
+    NodeArenaScope::~NodeArenaScope() {
+        currentArena = this->m_previousArena;
+    }
+
+    NodeArena *NodeArenaScope::getCurrentArena() {
+        return currentArena;
+    }
+
+}
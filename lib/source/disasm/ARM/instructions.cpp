@@ -0,0 +1,3 @@
+#include <disasm/ARM/instructions.hpp>
+
+DC_INSTANTIATE_ARCHITECTURE(dc::disasm::arm::v7::thumb::Architecture);
@@ -0,0 +1,3 @@
+#include <disasm/i8051/instructions.hpp>
+
+DC_INSTANTIATE_ARCHITECTURE(dc::disasm::i8051::Architecture);
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <test.hpp>
+
+#include <disasm/decode.hpp>
+#include <disasm/decoder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dc::test {
+
+    /* Index of an instruction within an InstructionArray */
+    template<std::derived_from<hlp::TypeArrayBase> T, typename Instr>
+    consteval u16 getInstructionIndex() {
+        return []<size_t ... Is>(std::index_sequence<Is...>) {
+            u16 result = T::Size;
+            ((std::is_same_v<typename T::template Get<Is>, Instr> ? (result = Is) : 0), ...);
+
+            return result;
+        }(std::make_index_sequence<T::Size>());
+    }
+
+    inline std::vector<u8> generateRandomBytes(size_t size, u32 seed = 0x4D3) {
+        std::mt19937 random(seed);
+
+        std::vector<u8> result(size);
+        for (auto &byte : result)
+            byte = u8(random());
+
+        return result;
+    }
+
+    /* Random bytes interrupted by runs of padding bytes, so data records of all kinds show up in the decoded output */
+    inline std::vector<u8> generateBytesWithDataRuns(size_t size, u32 seed = 0x4D3) {
+        std::mt19937 random(seed);
+
+        auto result = generateRandomBytes(size, seed);
+        for (size_t run = 0; run < size / 512; run++) {
+            const auto begin  = random() % size;
+            const auto length = std::min<size_t>(random() % 600, size - begin);
+            const auto value  = (random() % 2 == 0) ? 0xA5 : 0xFF;
+
+            std::fill_n(result.begin() + begin, length, u8(value));
+        }
+
+        return result;
+    }
+
+    /* Checks that two decodes produced the exact same records */
+    template<disasm::ArchitectureType T>
+    void checkSameRecords(std::span<const disasm::DecodedInstruction<T>> expected, std::span<const disasm::DecodedInstruction<T>> actual) {
+        if (!CHECK(expected.size() == actual.size()))
+            return;
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < expected.size(); i++) {
+            mismatches += expected[i].offset != actual[i].offset;
+            mismatches += expected[i].length != actual[i].length;
+            mismatches += expected[i].id != actual[i].id;
+            mismatches += expected[i].fields != actual[i].fields;
+        }
+
+        CHECK(mismatches == 0);
+    }
+
+    /*
+     * Checks that a decoder finds the same instruction as the LinearDecoder reference for every possible value of the
+     * first two bytes, followed by each of the given trailing bytes. Truncated inputs down to the empty span are checked as well.
+     */
+    template<std::derived_from<hlp::TypeArrayBase> T, template<typename> typename Decoder>
+    void checkAgainstLinearDecoder(std::span<const u8> trailingBytes = { }) {
+        size_t disagreements = 0;
+
+        std::array<u8, 8> bytes = { };
+        for (u32 word = 0x0000; word <= 0xFFFF; word++) {
+            bytes[0] = u8(word >> 8);
+            bytes[1] = u8(word);
+
+            for (size_t size = 0; size <= 2; size++) {
+                const auto instruction = std::span<const u8>(bytes).first(size);
+                disagreements += Decoder<T>::find(instruction) != disasm::LinearDecoder<T>::find(instruction);
+            }
+
+            for (u8 trailingByte : trailingBytes) {
+                std::fill(bytes.begin() + 2, bytes.end(), trailingByte);
+
+                for (size_t size = 3; size <= bytes.size(); size++) {
+                    const auto instruction = std::span<const u8>(bytes).first(size);
+                    disagreements += Decoder<T>::find(instruction) != disasm::LinearDecoder<T>::find(instruction);
+                }
+            }
+        }
+
+        CHECK(disagreements == 0);
+    }
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace dc::test {
+
+    struct TestCase {
+        std::string_view name;
+        std::function<void()> function;
+    };
+
+    inline std::vector<TestCase>& getTestCases() {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    inline size_t &getFailureCount() {
+        static size_t failureCount = 0;
+        return failureCount;
+    }
+
+    struct TestRegistration {
+        TestRegistration(std::string_view name, std::function<void()> function) {
+            getTestCases().push_back({ name, std::move(function) });
+        }
+    };
+
+    inline bool check(bool condition, std::string_view expression, std::string_view file, int line) {
+        if (!condition) {
+            getFailureCount()++;
+            fmt::print(stderr, "{}:{}: Check failed: {}\n", file, line, expression);
+        }
+
+        return condition;
+    }
+
+}
+
+/*
+ * Defines a test case. All test cases of a test executable are run one after another by the test runner.
+ */
+#define DC_TEST_CONCAT_IMPL(a, b) a##b
+#define DC_TEST_CONCAT(a, b) DC_TEST_CONCAT_IMPL(a, b)
+
+#define TEST_CASE(name)                                                                                             \
+    static void DC_TEST_CONCAT(testCase, __LINE__)();                                                               \
+    static ::dc::test::TestRegistration DC_TEST_CONCAT(testRegistration, __LINE__)(name, DC_TEST_CONCAT(testCase, __LINE__)); \
+    static void DC_TEST_CONCAT(testCase, __LINE__)()
+
+/* Checks a condition, reporting it and failing the test executable if it doesn't hold. Evaluates to the condition. */
+#define CHECK(condition) ::dc::test::check(bool(condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,100 @@
+#include <test.hpp>
+
+#include <ast/ast_node.hpp>
+#include <decomp/decompiler.hpp>
+
+#include <string_view>
+#include <type_traits>
+
+using namespace dc;
+
+namespace {
+
+    template<typename T>
+    constexpr ast::NodeKind getStaticKind() {
+        using enum ast::NodeKind;
+        if constexpr (std::is_same_v<T, ast::ASTNodeIntegerLiteral>)            return IntegerLiteral;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeRegister>)             return Register;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeFlag>)                 return Flag;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeJump>)                 return Jump;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeAssignment>)           return Assignment;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeUnaryArithmetic>)      return UnaryArithmetic;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeBinaryArithmetic>)     return BinaryArithmetic;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeConditional>)          return Conditional;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeControlFlowStatement>) return ControlFlowStatement;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeAssembly>)             return Assembly;
+        else if constexpr (std::is_same_v<T, ast::ASTNodeFunctionCall>)         return FunctionCall;
+    }
+
+    /* Visitor going through the virtual accept and visit calls, recording the type it was called with */
+    class KindVisitor final : public decomp::Visitor {
+    public:
+        void visit(ast::ASTNodeIntegerLiteral &) override           { this->kind = ast::NodeKind::IntegerLiteral; }
+        void visit(ast::ASTNodeJump &) override                     { this->kind = ast::NodeKind::Jump; }
+        void visit(ast::ASTNodeBinaryArithmetic &) override         { this->kind = ast::NodeKind::BinaryArithmetic; }
+        void visit(ast::ASTNodeRegister &) override                 { this->kind = ast::NodeKind::Register; }
+        void visit(ast::ASTNodeAssignment &) override               { this->kind = ast::NodeKind::Assignment; }
+        void visit(ast::ASTNodeUnaryArithmetic &) override          { this->kind = ast::NodeKind::UnaryArithmetic; }
+        void visit(ast::ASTNodeFlag &) override                     { this->kind = ast::NodeKind::Flag; }
+        void visit(ast::ASTNodeConditional &) override              { this->kind = ast::NodeKind::Conditional; }
+        void visit(ast::ASTNodeControlFlowStatement &) override     { this->kind = ast::NodeKind::ControlFlowStatement; }
+        void visit(ast::ASTNodeAssembly &) override                 { this->kind = ast::NodeKind::Assembly; }
+        void visit(ast::ASTNodeFunctionCall &) override             { this->kind = ast::NodeKind::FunctionCall; }
+
+        ast::NodeKind kind = { };
+    };
+
+    ast::NodeList createNodeOfEveryKind() {
+        using namespace ast;
+
+        return asVector(
+            create<ASTNodeIntegerLiteral>(1),
+            create<ASTNodeRegister>(2),
+            create<ASTNodeFlag>(3),
+            create<ASTNodeJump>(create<ASTNodeIntegerLiteral>(4)),
+            create<ASTNodeAssignment>(create<ASTNodeIntegerLiteral>(5), create<ASTNodeRegister>(6)),
+            create<ASTNodeUnaryArithmetic>(create<ASTNodeRegister>(7), ASTNodeUnaryArithmetic::Operator::BitNot),
+            create<ASTNodeBinaryArithmetic>(create<ASTNodeRegister>(8), create<ASTNodeIntegerLiteral>(9), ASTNodeBinaryArithmetic::Operator::Add),
+            create<ASTNodeConditional>(create<ASTNodeFlag>(10), NodeList { }, NodeList { }),
+            create<ASTNodeControlFlowStatement>(ASTNodeControlFlowStatement::Type::Return),
+            create<ASTNodeAssembly>("nop"),
+            create<ASTNodeFunctionCall>(create<ASTNodeIntegerLiteral>(11))
+        );
+    }
+
+}
+
+TEST_CASE("Nodes are dispatched with their concrete type") {
+    const auto nodes = createNodeOfEveryKind();
+    CHECK(nodes.size() == 11);
+
+    for (const auto &node : nodes) {
+        const auto kind = ast::dispatch(*node, []<typename T>(T &) { return getStaticKind<T>(); });
+        CHECK(kind == node->getKind());
+    }
+}
+
+TEST_CASE("Dispatching calls the same visit overloads as accept") {
+    KindVisitor virtualVisitor, staticVisitor;
+
+    for (const auto &node : createNodeOfEveryKind()) {
+        node->accept(virtualVisitor);
+        ast::dispatch(*node, [&](auto &concreteNode) { staticVisitor.visit(concreteNode); });
+
+        CHECK(virtualVisitor.kind == node->getKind());
+        CHECK(staticVisitor.kind == virtualVisitor.kind);
+    }
+}
+
+TEST_CASE("Dispatched visitors can read the members of the concrete node") {
+    auto node = ast::create<ast::ASTNodeAssembly>("mov A, R0");
+
+    const auto text = ast::dispatch(*node, []<typename T>(T &concreteNode) -> std::string_view {
+        if constexpr (std::is_same_v<T, ast::ASTNodeAssembly>)
+            return concreteNode.getAssembly();
+        else
+            return { };
+    });
+
+    CHECK(text == "mov A, R0");
+}
@@ -0,0 +1,96 @@
+#include <decoders.hpp>
+
+#include <ast/flat_tree.hpp>
+#include <decomp/decompiler.hpp>
+#include <decomp/ll_decompiler.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+#include <algorithm>
+#include <array>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+
+    using Binary = ast::ASTNodeBinaryArithmetic::Operator;
+    using Unary = ast::ASTNodeUnaryArithmetic::Operator;
+
+}
+
+TEST_CASE("Nodes are stored in the pool of their kind") {
+    ast::FlatTree tree;
+
+    const auto accumulator = tree.addRegister(3);
+    const auto literal     = tree.addIntegerLiteral(0x12);
+    const auto sum         = tree.addBinaryArithmetic(accumulator, literal, Binary::Add);
+    const auto destination = tree.addRegister(7);
+    const auto assignment  = tree.addAssignment(sum, destination);
+    tree.addStatement(assignment);
+
+    CHECK(accumulator.getKind() == ast::NodeKind::Register && accumulator.getIndex() == 0);
+    CHECK(destination.getKind() == ast::NodeKind::Register && destination.getIndex() == 1);
+    CHECK(literal.getKind() == ast::NodeKind::IntegerLiteral && literal.getIndex() == 0);
+    CHECK(sum.getKind() == ast::NodeKind::BinaryArithmetic && sum.getIndex() == 0);
+
+    constexpr std::array<ast::RegisterId, 2> Registers = { 3, 7 };
+    CHECK(std::ranges::equal(tree.getRegisters(), Registers));
+    CHECK(tree.getIntegerLiterals().size() == 1 && tree.getValue(literal) == 0x12);
+    CHECK(tree.getFlags().empty());
+
+    CHECK(tree.getSource(assignment) == sum);
+    CHECK(tree.getDestination(assignment) == destination);
+    CHECK(tree.getLeftHandSide(sum) == accumulator);
+    CHECK(tree.getRightHandSide(sum) == literal);
+    CHECK(tree.getBinaryOperator(sum) == Binary::Add);
+    CHECK(tree.getStatements().size() == 1 && tree.getStatements()[0] == assignment);
+
+    const auto flag      = tree.addFlag(1);
+    const auto condition = tree.addUnaryArithmetic(flag, Unary::BoolNot);
+    const auto jump      = tree.addJump(tree.addIntegerLiteral(0x100));
+    const auto assembly  = tree.addAssembly(" nop ");
+    const std::array<ast::NodeRef, 2> trueBlock = { jump, assembly };
+    const auto conditional = tree.addConditional(condition, trueBlock, { });
+
+    CHECK(tree.getCondition(conditional) == condition);
+    CHECK(tree.getOperand(condition) == flag && tree.getUnaryOperator(condition) == Unary::BoolNot);
+    CHECK(std::ranges::equal(tree.getTrueBlock(conditional), trueBlock));
+    CHECK(tree.getFalseBlock(conditional).empty());
+    CHECK(tree.getAssembly(assembly) == " nop ");
+
+    tree.clear();
+    CHECK(tree.getStatements().empty() && tree.getRegisters().empty() && tree.getIntegerLiterals().empty());
+}
+
+TEST_CASE("Flat trees print the same as the ASTs they were converted from") {
+    const auto bytes = test::generateRandomBytes(16 * 1024);
+    auto ast = decomp::decompile<i8051>(bytes);
+
+    ast.push_back(ast::create<ast::ASTNodeConditional>(
+        ast::create<ast::ASTNodeUnaryArithmetic>(ast::create<ast::ASTNodeBinaryArithmetic>(ast::create<ast::ASTNodeRegister>(0), ast::create<ast::ASTNodeIntegerLiteral>(1), Binary::BitAnd), Unary::BitNot),
+        ast::asVector(ast::create<ast::ASTNodeControlFlowStatement>(ast::ASTNodeControlFlowStatement::Type::Break)),
+        ast::asVector(ast::create<ast::ASTNodeFunctionCall>(ast::create<ast::ASTNodeIntegerLiteral>(0x1234)), ast::create<ast::ASTNodeAssembly>("  nop  "))
+    ));
+
+    const auto tree = ast::FlatTree::flatten(ast);
+    if (!CHECK(tree.getStatements().size() == ast.size()))
+        return;
+
+    decomp::MemorySink pointerOutput, flatOutput;
+    decomp::LowLevelDecompiler pointerPrinter(pointerOutput, i8051::Registers, i8051::Flags);
+    decomp::LowLevelDecompiler flatPrinter(flatOutput, i8051::Registers, i8051::Flags);
+
+    for (const auto &node : ast) {
+        node->accept(pointerPrinter);
+        pointerOutput.print(";\n");
+    }
+
+    for (auto node : tree.getStatements()) {
+        flatPrinter.print(tree, node);
+        flatOutput.print(";\n");
+    }
+
+    CHECK(!pointerOutput.getText().empty());
+    CHECK(flatOutput.getText() == pointerOutput.getText());
+}
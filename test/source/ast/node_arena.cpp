@@ -0,0 +1,116 @@
+#include <test.hpp>
+
+#include <ast/ast_node.hpp>
+#include <ast/node_arena.hpp>
+
+using namespace dc;
+
+namespace {
+
+    /* Node counting how often its destructor ran */
+    class CountingNode : public ast::ASTNode {
+    public:
+        explicit CountingNode(size_t &destructions) : ASTNode(ast::NodeKind::IntegerLiteral), m_destructions(destructions) { }
+        ~CountingNode() override { this->m_destructions++; }
+
+        void accept(decomp::Visitor &) override { }
+
+    private:
+        size_t &m_destructions;
+    };
+
+    constexpr auto LongAssembly = "a string too long to be stored inside of the string object itself";
+
+}
+
+TEST_CASE("Nodes, node lists and strings come from the active arena") {
+    ast::NodeArena arena;
+
+    {
+        ast::NodeArenaScope scope(arena);
+
+        auto list = ast::asVector(ast::create<ast::ASTNodeIntegerLiteral>(1), ast::create<ast::ASTNodeAssembly>(LongAssembly));
+        CHECK(list.get_allocator().getArena() == &arena);
+        CHECK(list[0]->isArenaAllocated());
+        CHECK(list[1]->isArenaAllocated());
+        CHECK(static_cast<ast::ASTNodeAssembly&>(*list[1]).getAssembly().get_allocator().getArena() == &arena);
+        CHECK(static_cast<ast::ASTNodeAssembly&>(*list[1]).getAssembly() == LongAssembly);
+    }
+
+    const auto allocatedSize = arena.getAllocatedSize();
+    CHECK(allocatedSize > 0);
+
+    auto list = ast::asVector(ast::create<ast::ASTNodeAssembly>(LongAssembly));
+    CHECK(list.get_allocator().getArena() == nullptr);
+    CHECK(!list[0]->isArenaAllocated());
+    CHECK(static_cast<ast::ASTNodeAssembly&>(*list[0]).getAssembly().get_allocator().getArena() == nullptr);
+    CHECK(arena.getAllocatedSize() == allocatedSize);
+}
+
+TEST_CASE("Arena scopes nest and restore the previous arena") {
+    ast::NodeArena outer, inner;
+
+    CHECK(ast::NodeArenaScope::getCurrentArena() == nullptr);
+    {
+        ast::NodeArenaScope outerScope(outer);
+        CHECK(ast::NodeArenaScope::getCurrentArena() == &outer);
+
+        {
+            ast::NodeArenaScope innerScope(inner);
+            CHECK(ast::NodeArenaScope::getCurrentArena() == &inner);
+
+            auto node = ast::create<ast::ASTNodeIntegerLiteral>(1);
+        }
+
+        CHECK(ast::NodeArenaScope::getCurrentArena() == &outer);
+    }
+    CHECK(ast::NodeArenaScope::getCurrentArena() == nullptr);
+
+    CHECK(outer.getAllocatedSize() == 0);
+    CHECK(inner.getAllocatedSize() > 0);
+}
+
+TEST_CASE("Arena nodes are released without running their destructors") {
+    size_t destructions = 0;
+
+    ast::NodeArena arena;
+    {
+        ast::NodeArenaScope scope(arena);
+
+        auto list = ast::asVector(ast::create<CountingNode>(destructions), ast::create<CountingNode>(destructions));
+    }
+    CHECK(destructions == 0);
+
+    auto node = ast::create<CountingNode>(destructions);
+    node.reset();
+    CHECK(destructions == 1);
+}
+
+TEST_CASE("Resetting an arena drops all allocations and reuses the first block") {
+    ast::NodeArena arena(256);
+
+    {
+        ast::NodeArenaScope scope(arena);
+
+        for (size_t i = 0; i < 64; i++)
+            auto node = ast::create<ast::ASTNodeIntegerLiteral>(i);
+    }
+
+    CHECK(arena.getBlockCount() > 1);
+
+    arena.reset();
+    CHECK(arena.getBlockCount() == 1);
+    CHECK(arena.getAllocatedSize() == 0);
+
+    {
+        ast::NodeArenaScope scope(arena);
+        auto node = ast::create<ast::ASTNodeIntegerLiteral>(1);
+    }
+
+    CHECK(arena.getBlockCount() == 1);
+    CHECK(arena.getAllocatedSize() > 0);
+
+    /* Allocations larger than a block get a block of their own */
+    std::ignore = arena.allocate(1024);
+    CHECK(arena.getBlockCount() == 2);
+}
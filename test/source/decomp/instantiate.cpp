@@ -0,0 +1,40 @@
+#include <decoders.hpp>
+
+#include <decomp/decompiler.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    /*
+     * The default decoder entry points are declared extern by the architecture headers and come from the library.
+     * Going through the LinearDecoder instantiates everything in this translation unit instead, so both have to agree.
+     */
+    template<disasm::ArchitectureType T>
+    void checkLibraryInstances(std::span<const u8> bytes) {
+        const auto instructions = disasm::decode<T>(bytes);
+        test::checkSameRecords<T>(disasm::decode<T, disasm::LinearDecoder>(bytes), instructions);
+
+        const auto lines = disasm::disassemble<T>(bytes);
+        const auto linearLines = disasm::disassemble<T, disasm::LinearDecoder>(bytes);
+        CHECK(lines == linearLines);
+        CHECK(disasm::disassemble<T>(bytes, instructions) == lines);
+
+        const auto linearAst = decomp::decompile<T, disasm::LinearDecoder>(bytes);
+        CHECK(decomp::decompile<T>(bytes).size() == linearAst.size());
+    }
+
+}
+
+TEST_CASE("Library instances of the 8051 entry points match local instances") {
+    checkLibraryInstances<i8051>(test::generateRandomBytes(16 * 1024));
+}
+
+TEST_CASE("Library instances of the Thumb entry points match local instances") {
+    checkLibraryInstances<Thumb>(test::generateRandomBytes(16 * 1024));
+}
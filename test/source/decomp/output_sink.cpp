@@ -0,0 +1,90 @@
+#include <test.hpp>
+
+#include <decomp/output_sink.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace dc;
+
+namespace {
+
+    std::string readAll(std::FILE *file) {
+        std::rewind(file);
+
+        std::string result;
+        for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file))
+            result += char(c);
+
+        return result;
+    }
+
+}
+
+TEST_CASE("Sinks only write once flushed or once their buffer is full") {
+    std::vector<std::string> chunks;
+
+    {
+        decomp::CallbackSink sink([&](std::string_view text) { chunks.emplace_back(text); });
+
+        sink.print("{} + {}", 1, 2);
+        sink.print(";\n");
+        CHECK(chunks.empty());
+
+        sink.flush();
+        if (CHECK(chunks.size() == 1))
+            CHECK(chunks[0] == "1 + 2;\n");
+
+        sink.flush();
+        CHECK(chunks.size() == 1);
+
+        const std::string line(1024, 'x');
+        for (size_t i = 0; i < decomp::OutputSink::FlushThreshold / line.size(); i++)
+            sink.print("{}", line);
+
+        if (CHECK(chunks.size() == 2))
+            CHECK(chunks[1].size() == decomp::OutputSink::FlushThreshold);
+
+        sink.print("tail");
+    }
+
+    /* Destroying the sink flushes what's left */
+    if (CHECK(chunks.size() == 3))
+        CHECK(chunks[2] == "tail");
+}
+
+TEST_CASE("Memory sinks keep all text in order") {
+    decomp::MemorySink sink;
+
+    sink.print("a");
+    sink.print("{}", 'b');
+    CHECK(sink.getText() == "ab");
+
+    sink.print("c");
+    CHECK(sink.getText() == "abc");
+
+    sink.clear();
+    sink.print("d");
+    CHECK(sink.getText() == "d");
+}
+
+TEST_CASE("File sinks keep their order with direct writes to the same file when flushed in between") {
+    std::FILE *file = std::tmpfile();
+    if (!CHECK(file != nullptr))
+        return;
+
+    {
+        decomp::FileSink sink(file);
+
+        std::fputs("first\n", file);
+        sink.print("second\n");
+        sink.flush();
+
+        std::fputs("third\n", file);
+        sink.print("fourth\n");
+    }
+
+    CHECK(readAll(file) == "first\nsecond\nthird\nfourth\n");
+    std::fclose(file);
+}
@@ -0,0 +1,65 @@
+#include <decoders.hpp>
+
+#include <disasm/ARM/classify.hpp>
+#include <disasm/ARM/instructions.hpp>
+
+using namespace dc;
+using namespace dc::disasm::arm::v7::thumb;
+
+namespace {
+
+    using Instructions = Architecture::Instructions;
+
+}
+
+TEST_CASE("Batched classification matches scalar classification") {
+    // Odd sizes leave a trailing byte and halfwords that don't fill a whole SIMD block
+    for (size_t size : { 0, 1, 2, 15, 16, 17, 33, 4097 }) {
+        const auto bytes = test::generateRandomBytes(size, u32(size));
+        const auto groups = classify(bytes);
+
+        if (!CHECK(groups.size() == size / sizeof(u16)))
+            continue;
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < groups.size(); i++)
+            mismatches += groups[i] != classify(u16(bytes[i * 2] | (bytes[i * 2 + 1] << 8)));
+
+        CHECK(mismatches == 0);
+    }
+}
+
+TEST_CASE("Every halfword belongs to a known group") {
+    size_t unknown = 0;
+    for (u32 halfword = 0x0000; halfword <= 0xFFFF; halfword++)
+        unknown += classify(u16(halfword)) == Group::Unknown;
+
+    CHECK(unknown == 0);
+}
+
+TEST_CASE("Instructions are found in the group of their halfword") {
+    CHECK(classify(u16(0xBF00)) == Group::Miscellaneous);   // nop
+    CHECK(classify(u16(0x4148)) == Group::DataProcessing);  // adc
+    CHECK(classify(u16(0xE7FE)) == Group::UnconditionalBranch);
+    CHECK(classify(u16(0xF000)) == Group::Wide);
+
+    CHECK(GroupedDecoder<Instructions>::getCandidateCount(Group::Wide) == 0);
+    CHECK(GroupedDecoder<Instructions>::find(std::array<u8, 2>{ 0x00, 0xF0 }) == GroupedDecoder<Instructions>::NotFound);
+}
+
+TEST_CASE("Grouped decoder matches linear decoder") {
+    test::checkAgainstLinearDecoder<Instructions, GroupedDecoder>();
+}
+
+TEST_CASE("Batched grouped lookups match single lookups") {
+    const auto bytes = test::generateRandomBytes(64 * 1024 + 3);
+
+    std::vector<u16> indices(bytes.size() / sizeof(u16));
+    GroupedDecoder<Instructions>::findAll(bytes, indices);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < indices.size(); i++)
+        mismatches += indices[i] != GroupedDecoder<Instructions>::find(std::span(bytes).subspan(i * sizeof(u16), sizeof(u16)));
+
+    CHECK(mismatches == 0);
+}
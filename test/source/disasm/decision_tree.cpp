@@ -0,0 +1,38 @@
+#include <decoders.hpp>
+
+#include <disasm/decision_tree.hpp>
+#include <disasm/ARM/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    constexpr std::array<u8, 4> TrailingBytes = { 0x00, 0x5A, 0xA5, 0xFF };
+
+    template<hlp::StaticString PatternValue>
+    struct InstrTest : public disasm::Instruction<"test", PatternValue, disasm::Category::Other, std::endian::little> {
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
+
+        static ast::NodeList decompile(u64, std::span<const u8>) {
+            return { };
+        }
+    };
+
+    /* 32 bit instructions with fixed bits spread over all four bytes, including overlapping ones */
+    using WideInstructions = disasm::InstructionArray<
+            InstrTest<"1111'0000'xxxx'xxxx'xxxx'xxxx'0000'1111">,
+            InstrTest<"1111'0xxx'xxxx'xxxx'xxxx'xxxx'xxxx'xxxx">,
+            InstrTest<"xxxx'xxxx'1010'xxxx'xxxx'0101'xxxx'xxxx">,
+            InstrTest<"0000'0000'0000'0000'0000'0000'0000'0000">,
+            InstrTest<"0xxx'xxxx'xxxx'xxxx'xxxx'xxxx'xxxx'xxx1">
+    >;
+
+}
+
+TEST_CASE("Thumb decision tree matches linear decoder") {
+    test::checkAgainstLinearDecoder<disasm::arm::v7::thumb::Architecture::Instructions, disasm::DecisionTreeDecoder>();
+}
+
+TEST_CASE("Decision tree matches linear decoder for 32 bit instructions") {
+    test::checkAgainstLinearDecoder<WideInstructions, disasm::DecisionTreeDecoder>(TrailingBytes);
+}
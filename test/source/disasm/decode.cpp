@@ -0,0 +1,169 @@
+#include <decoders.hpp>
+
+#include <disasm/decode.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    /* Records need to cover the input without gaps and agree with a lookup at their offset */
+    template<disasm::ArchitectureType T>
+    void checkRecords(std::span<const u8> bytes, std::span<const disasm::DecodedInstruction<T>> instructions) {
+        using Decoder = disasm::OpcodeTable<typename T::Instructions>;
+
+        u64 offset = 0x00;
+        size_t mismatches = 0;
+        for (const auto &instruction : instructions) {
+            mismatches += instruction.offset != offset || instruction.length == 0;
+
+            const auto index = Decoder::find(bytes.subspan(instruction.offset));
+            if (instruction.isValid())
+                mismatches += index != instruction.id;
+            else
+                mismatches += index != Decoder::NotFound;
+
+            offset += instruction.length;
+        }
+
+        CHECK(mismatches == 0);
+        CHECK(offset == bytes.size());
+    }
+
+}
+
+TEST_CASE("Decoded records hold the placeholder values") {
+    // mov R7, #0x12; lcall #0x1234
+    constexpr std::array<u8, 5> Bytes = { 0x7F, 0x12, 0x12, 0x12, 0x34 };
+
+    const auto instructions = disasm::decode<i8051>(Bytes);
+    if (!CHECK(instructions.size() == 2))
+        return;
+
+    CHECK(instructions[0].offset == 0);
+    CHECK(instructions[0].length == 2);
+    CHECK(instructions[0].id == (test::getInstructionIndex<i8051::Instructions, disasm::i8051::InstrMOVRegImmediate>()));
+    CHECK(instructions[0].category == disasm::Category::RegisterAccess);
+    CHECK(instructions[0].fields[0] == 7);
+    CHECK(instructions[0].fields[1] == 0x12);
+
+    CHECK(instructions[1].offset == 2);
+    CHECK(instructions[1].length == 3);
+    CHECK(instructions[1].id == (test::getInstructionIndex<i8051::Instructions, disasm::i8051::InstrLCall>()));
+    CHECK(instructions[1].category == disasm::Category::FunctionCall);
+    CHECK(instructions[1].fields[0] == 0x1234);
+}
+
+TEST_CASE("Decoded records cover random input") {
+    const auto bytes = test::generateRandomBytes(64 * 1024);
+
+    checkRecords<i8051>(bytes, disasm::decode<i8051>(bytes));
+    checkRecords<Thumb>(bytes, disasm::decode<Thumb>(bytes));
+}
+
+TEST_CASE("Decoding stops at the end of truncated input") {
+    // lcall with only two of its three bytes
+    constexpr std::array<u8, 2> Bytes = { 0x12, 0x12 };
+
+    const auto instructions = disasm::decode<i8051>(Bytes);
+    if (!CHECK(!instructions.empty()))
+        return;
+
+    CHECK(!instructions[0].isValid());
+    checkRecords<i8051>(Bytes, instructions);
+}
+
+TEST_CASE("Decoded image columns match the decoded records") {
+    const auto bytes = test::generateRandomBytes(64 * 1024);
+
+    const auto instructions = disasm::decode<i8051>(bytes);
+    const auto image = disasm::decodeImage<i8051>(bytes);
+
+    if (!CHECK(image.size() == instructions.size()))
+        return;
+
+    CHECK(image.fields.size() == image.size() * disasm::DecodedImage<i8051>::FieldStride);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < instructions.size(); i++) {
+        const auto &instruction = instructions[i];
+
+        mismatches += image.offsets[i] != instruction.offset;
+        mismatches += image.lengths[i] != instruction.length;
+        mismatches += image.ids[i] != instruction.id;
+        mismatches += !std::equal(instruction.fields.begin(), instruction.fields.end(), image.getFields(i).begin(), image.getFields(i).end());
+    }
+
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Runs of identical undecodable bytes become fill records") {
+    // nop; 300 times the only undefined 8051 opcode; nop
+    std::vector<u8> bytes(302, 0xA5);
+    bytes.front() = 0x00;
+    bytes.back()  = 0x00;
+
+    const auto instructions = disasm::decode<i8051>(bytes);
+    if (!CHECK(instructions.size() == 4))
+        return;
+
+    CHECK(instructions[1].length == disasm::DecodedInstruction<i8051>::MaxFillLength);
+    CHECK(instructions[2].length == 300 - disasm::DecodedInstruction<i8051>::MaxFillLength);
+    checkRecords<i8051>(bytes, instructions);
+
+    CHECK(disasm::disassembleInstruction<i8051>(instructions[1], bytes) == ".fill 255, 1, 0xA5");
+    CHECK(disasm::disassembleInstruction<i8051>(instructions[2], bytes) == ".fill 45, 1, 0xA5");
+}
+
+TEST_CASE("Short runs of identical undecodable bytes are listed byte by byte") {
+    constexpr std::array<u8, 3> Bytes = { 0xA5, 0xA5, 0xA5 };
+
+    const auto instructions = disasm::decode<i8051>(Bytes);
+    if (!CHECK(instructions.size() == 1))
+        return;
+
+    CHECK(disasm::disassembleInstruction<i8051>(instructions[0], Bytes) == ".byte 0xA5, 0xA5, 0xA5");
+}
+
+TEST_CASE("Differing undecodable bytes are split into records of limited length around fill runs") {
+    using Record  = disasm::DecodedInstruction<Thumb>;
+    using Decoder = disasm::OpcodeTable<Thumb::Instructions>;
+
+    // Undecodable halfwords made up of two different bytes
+    std::vector<std::array<u8, 2>> undecodable;
+    for (u32 word = 0x0000; word <= 0xFFFF; word++) {
+        const std::array<u8, 2> halfword = { u8(word), u8(word >> 8) };
+        if (halfword[0] != halfword[1] && Decoder::find(halfword) == Decoder::NotFound)
+            undecodable.push_back(halfword);
+    }
+
+    constexpr std::array<u8, 2> Padding = { 0xFF, 0xFF };
+    if (!CHECK(undecodable.size() >= 24) || !CHECK(Decoder::find(Padding) == Decoder::NotFound))
+        return;
+
+    // 20 differing halfwords, 4 padding halfwords and 2 more differing halfwords
+    std::vector<u8> bytes;
+    for (size_t i = 0; i < 20; i++)
+        bytes.insert(bytes.end(), undecodable[i].begin(), undecodable[i].end());
+    for (size_t i = 0; i < 4; i++)
+        bytes.insert(bytes.end(), Padding.begin(), Padding.end());
+    for (size_t i = 20; i < 22; i++)
+        bytes.insert(bytes.end(), undecodable[i].begin(), undecodable[i].end());
+
+    const auto instructions = disasm::decode<Thumb>(bytes);
+    checkRecords<Thumb>(bytes, instructions);
+    if (!CHECK(instructions.size() == 5))
+        return;
+
+    CHECK(instructions[0].length == Record::MaxDataRunLength);
+    CHECK(instructions[1].length == Record::MaxDataRunLength);
+    CHECK(instructions[2].length == 40 - 2 * Record::MaxDataRunLength);
+    CHECK(instructions[3].length == 8);
+    CHECK(instructions[4].length == 4);
+
+    CHECK(disasm::disassembleInstruction<Thumb>(instructions[3], bytes) == ".fill 8, 1, 0xFF");
+}
@@ -0,0 +1,82 @@
+#include <decoders.hpp>
+
+#include <disasm/disassembler.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+#include <iterator>
+#include <string>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    /* Text written into a buffer needs to be the same as the strings returned for every single instruction */
+    template<disasm::ArchitectureType T>
+    void checkBufferMatchesStrings(std::span<const u8> bytes) {
+        const auto lines = disasm::disassemble<T>(bytes);
+
+        std::string expected;
+        for (const auto &line : lines)
+            expected += line + '\n';
+
+        fmt::memory_buffer buffer;
+        disasm::disassemble<T>(buffer, bytes);
+
+        CHECK(fmt::to_string(buffer) == expected);
+    }
+
+}
+
+TEST_CASE("Buffer disassembly matches the string overloads") {
+    const auto bytes = test::generateRandomBytes(16 * 1024);
+
+    checkBufferMatchesStrings<i8051>(bytes);
+    checkBufferMatchesStrings<Thumb>(bytes);
+}
+
+TEST_CASE("Single instructions are written to output iterators and appended to buffers") {
+    // mov R7, #0x12; lcall #0x1234
+    constexpr std::array<u8, 5> Bytes = { 0x7F, 0x12, 0x12, 0x12, 0x34 };
+
+    const auto instructions = disasm::decode<i8051>(Bytes);
+    if (!CHECK(instructions.size() == 2))
+        return;
+
+    std::string text;
+    disasm::disassembleInstruction<i8051>(std::back_inserter(text), instructions[0], Bytes);
+    CHECK(text == "mov R7, #0x0012");
+
+    disasm::InstructionBuffer buffer;
+    disasm::disassembleInstruction<i8051>(buffer, instructions[0], Bytes);
+    disasm::disassembleInstruction<i8051>(buffer, instructions[1], Bytes);
+    CHECK(fmt::to_string(buffer) == "mov R7, #0x0012lcall #0x1234");
+}
+
+namespace {
+
+    template<typename Instr>
+    std::string formatOperands(std::span<const u8> bytes) {
+        disasm::InstructionBuffer buffer;
+        Instr::disassemble(fmt::appender(buffer), 0x00, bytes);
+
+        return fmt::to_string(buffer);
+    }
+
+}
+
+TEST_CASE("Thumb operand lists are written with one compiled format string") {
+    using namespace disasm::arm::v7::thumb;
+
+    // adc R5, R3
+    CHECK(formatOperands<InstrADCRegister>(std::array<u8, 2> { 0x6B, 0x41 }) == "adc R5, R3");
+    // ldr R0, [R1, #4]
+    CHECK(formatOperands<InstrLDRImmediateT1>(std::array<u8, 2> { 0x48, 0x68 }) == "ldr R0, R1, #4");
+    // beq #-4
+    CHECK(formatOperands<InstrBT1>(std::array<u8, 2> { 0xFE, 0xD0 }) == "b EQ, #-4");
+    // it EQ
+    CHECK(formatOperands<InstrIT>(std::array<u8, 2> { 0x08, 0xBF }) == "it EQ");
+}
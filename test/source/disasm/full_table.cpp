@@ -0,0 +1,54 @@
+#include <decoders.hpp>
+
+#include <disasm/decision_tree.hpp>
+#include <disasm/full_table.hpp>
+#include <disasm/opcode_table.hpp>
+#include <disasm/ARM/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    constexpr std::array<u8, 4> TrailingBytes = { 0x00, 0x5A, 0xA5, 0xFF };
+
+    template<hlp::StaticString PatternValue>
+    struct InstrTest : public disasm::Instruction<"test", PatternValue, disasm::Category::Other, std::endian::big> {
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
+
+        static ast::NodeList decompile(u64, std::span<const u8>) {
+            return { };
+        }
+    };
+
+    /* Single byte instructions, overlapping ones are resolved in InstructionArray order */
+    using ByteInstructions = disasm::InstructionArray<
+            InstrTest<"1010'0101">,
+            InstrTest<"1010'xxxx">,
+            InstrTest<"xxxx'0101">,
+            InstrTest<"0xx0'1xx1">
+    >;
+
+}
+
+TEST_CASE("Thumb full table matches linear decoder") {
+    test::checkAgainstLinearDecoder<disasm::arm::v7::thumb::Architecture::Instructions, disasm::FullTableDecoder>();
+}
+
+TEST_CASE("Full table matches linear decoder for single byte instructions") {
+    test::checkAgainstLinearDecoder<ByteInstructions, disasm::FullTableDecoder>(TrailingBytes);
+}
+
+TEST_CASE("All Thumb decoders agree on every halfword") {
+    using Instructions = disasm::arm::v7::thumb::Architecture::Instructions;
+
+    size_t disagreements = 0;
+    for (u32 word = 0x0000; word <= 0xFFFF; word++) {
+        const std::array<u8, 2> bytes = { u8(word), u8(word >> 8) };
+
+        const auto expected = disasm::FullTableDecoder<Instructions>::find(bytes);
+        disagreements += disasm::OpcodeTable<Instructions>::find(bytes) != expected;
+        disagreements += disasm::DecisionTreeDecoder<Instructions>::find(bytes) != expected;
+    }
+
+    CHECK(disagreements == 0);
+}
@@ -0,0 +1,92 @@
+#include <decoders.hpp>
+
+#include <decomp/decompiler.hpp>
+#include <decomp/ll_decompiler.hpp>
+#include <decomp/output_sink.hpp>
+#include <disasm/disassembler.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+
+    /* Disassembly and decompilation of the first instruction of the bytes, placed at the given address */
+    struct Output {
+        std::string disassembly, decompilation;
+    };
+
+    Output translate(u64 address, std::span<const u8> bytes) {
+        auto instruction = disasm::decodeInstruction<i8051>(0x00, bytes);
+        instruction.offset = address;
+
+        // Instructions read their bytes relative to the record's offset
+        std::vector<u8> image(address);
+        image.insert(image.end(), bytes.begin(), bytes.end());
+
+        decomp::MemorySink sink;
+        decomp::LowLevelDecompiler decompiler(sink, i8051::Registers, i8051::Flags);
+
+        const std::array instructions = { instruction };
+        for (const auto &node : decomp::decompile<i8051>(image, std::span(instructions)))
+            decompiler.print(*node);
+
+        return { disasm::disassembleInstruction<i8051>(instruction, image), sink.getText() };
+    }
+
+}
+
+TEST_CASE("Every 8051 opcode except 0xA5 decodes") {
+    using Decoder = disasm::OpcodeTable<i8051::Instructions>;
+
+    size_t undecodable = 0;
+    for (u32 opcode = 0x00; opcode <= 0xFF; opcode++) {
+        const std::array<u8, 3> bytes = { u8(opcode), 0x00, 0x00 };
+        if (Decoder::find(bytes) == Decoder::NotFound) {
+            CHECK(opcode == 0xA5);
+            undecodable++;
+        }
+    }
+
+    CHECK(undecodable == 1);
+}
+
+TEST_CASE("Relative jump offsets are signed and relative to the following instruction") {
+    // sjmp -2, jumping to itself
+    auto output = translate(0x100, std::array<u8, 2> { 0x80, 0xFE });
+    CHECK(output.disassembly == "sjmp #0x100");
+    CHECK(output.decompilation == "goto 0x100");
+
+    // jz +0x7F
+    output = translate(0x100, std::array<u8, 2> { 0x60, 0x7F });
+    CHECK(output.disassembly == "jz #0x181");
+    CHECK(output.decompilation.find("goto 0x181") != std::string::npos);
+
+    // cjne A, #0x12, -0x80
+    output = translate(0x100, std::array<u8, 3> { 0xB4, 0x12, 0x80 });
+    CHECK(output.disassembly == "cjne A, #0x12, #0x83");
+    CHECK(output.decompilation.find("goto 0x83") != std::string::npos);
+
+    // jbc 0x20, -3, looping on itself
+    output = translate(0x100, std::array<u8, 3> { 0x10, 0x20, 0xFD });
+    CHECK(output.disassembly.ends_with(", #0x100"));
+    CHECK(output.decompilation.find("goto 0x100") != std::string::npos);
+
+    // djnz 0x30, -3 is three bytes long as well
+    output = translate(0x100, std::array<u8, 3> { 0xD5, 0x30, 0xFD });
+    CHECK(output.disassembly == "djnz #0x30, #0x100");
+    CHECK(output.decompilation.find("goto 0x100") != std::string::npos);
+}
+
+TEST_CASE("Relative jump targets wrap around the code address space") {
+    // sjmp -0x80 at the start of the address space
+    const auto output = translate(0x10, std::array<u8, 2> { 0x80, 0x80 });
+    CHECK(output.disassembly == "sjmp #0xFF92");
+}
+
+TEST_CASE("Code memory reads parenthesize their address") {
+    const auto output = translate(0x00, std::array<u8, 1> { 0x93 });
+    CHECK(output.disassembly == "movc A, @A+DPTR");
+    CHECK(output.decompilation == "A = *(A + DPTR)");
+}
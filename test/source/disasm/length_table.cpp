@@ -0,0 +1,83 @@
+#include <decoders.hpp>
+
+#include <disasm/length_table.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    // Large enough to be split into several chunks
+    constexpr size_t ImageSize = 1024 * 1024;
+
+    /* Every offset's length needs to be the one decodeInstruction returns when decoding from there */
+    template<disasm::ArchitectureType T>
+    void checkInstructionLengths(std::span<const u8> bytes, hlp::ThreadPool &pool) {
+        const auto lengths = disasm::getInstructionLengths<T>(bytes, pool);
+        if (!CHECK(lengths.size() == bytes.size()))
+            return;
+
+        size_t mismatches = 0;
+        for (u64 offset = 0x00; offset < bytes.size(); offset++)
+            mismatches += lengths[offset] != disasm::decodeInstruction<T>(offset, bytes).length;
+
+        CHECK(mismatches == 0);
+    }
+
+    /* Boundaries need to be the offsets a serial walk over the lengths visits */
+    template<disasm::ArchitectureType T>
+    void checkInstructionBoundaries(std::span<const u8> lengths, hlp::ThreadPool &pool, u64 entry) {
+        std::vector<u64> expected;
+        for (u64 offset = entry; offset < lengths.size(); offset += lengths[offset])
+            expected.push_back(offset);
+
+        CHECK(disasm::findInstructionBoundaries<T>(lengths, pool, entry) == expected);
+    }
+
+}
+
+TEST_CASE("Instruction lengths match the decoder at every offset") {
+    hlp::ThreadPool pool(4);
+    const auto bytes = test::generateBytesWithDataRuns(ImageSize);
+
+    checkInstructionLengths<i8051>(bytes, pool);
+    checkInstructionLengths<Thumb>(bytes, pool);
+}
+
+TEST_CASE("Instruction lengths near the end of the input account for truncated instructions") {
+    hlp::ThreadPool pool(4);
+
+    // lcall with only two of its three bytes, preceded by complete ones
+    const std::array<u8, 8> bytes = { 0x12, 0x12, 0x34, 0x12, 0x12, 0x34, 0x12, 0x12 };
+
+    checkInstructionLengths<i8051>(bytes, pool);
+}
+
+TEST_CASE("Instruction boundaries match a serial walk over the lengths") {
+    hlp::ThreadPool pool(4);
+    const auto bytes = test::generateBytesWithDataRuns(ImageSize);
+    const auto lengths = disasm::getInstructionLengths<i8051>(bytes, pool);
+
+    for (u64 entry : { 0, 1, 2, 0x12345 })
+        checkInstructionBoundaries<i8051>(lengths, pool, entry);
+}
+
+TEST_CASE("Decoding with the length table matches the serial decode") {
+    hlp::ThreadPool pool(4);
+
+    for (u32 seed : { 1, 2, 3 }) {
+        const auto bytes = test::generateBytesWithDataRuns(ImageSize, seed);
+
+        test::checkSameRecords<i8051>(disasm::decode<i8051>(bytes), disasm::decodeWithLengthTable<i8051>(bytes, pool));
+    }
+
+    for (size_t size : { 0, 1, 2, 3, 101 }) {
+        const auto bytes = test::generateBytesWithDataRuns(size);
+
+        test::checkSameRecords<i8051>(disasm::decode<i8051>(bytes), disasm::decodeWithLengthTable<i8051>(bytes, pool));
+    }
+}
@@ -0,0 +1,92 @@
+#include <decoders.hpp>
+
+#include <disasm/linear_sweep.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+#include <iterator>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    /* Sweeping needs to produce exactly the records decode() materializes, in the same order */
+    template<disasm::ArchitectureType T>
+    void checkSweepMatchesDecode(std::span<const u8> bytes) {
+        const auto instructions = disasm::decode<T>(bytes);
+
+        size_t count = 0, mismatches = 0;
+        for (const auto &view : disasm::sweep<T>(bytes)) {
+            if (count < instructions.size()) {
+                const auto &expected = instructions[count];
+                const auto &instruction = view.getInstruction();
+
+                mismatches += instruction.offset != expected.offset;
+                mismatches += instruction.length != expected.length;
+                mismatches += instruction.id != expected.id;
+                mismatches += instruction.fields != expected.fields;
+            }
+
+            count++;
+        }
+
+        CHECK(count == instructions.size());
+        CHECK(mismatches == 0);
+    }
+
+}
+
+TEST_CASE("Sweeping yields the same records as decoding") {
+    const auto bytes = test::generateRandomBytes(64 * 1024);
+
+    checkSweepMatchesDecode<i8051>(bytes);
+    checkSweepMatchesDecode<Thumb>(bytes);
+}
+
+TEST_CASE("Sweeping empty input yields no instructions") {
+    const auto sweep = disasm::sweep<i8051>({ });
+
+    CHECK(sweep.begin() == std::default_sentinel);
+}
+
+TEST_CASE("Sweeping starts at the given offset") {
+    // nop; mov R7, #0x12; lcall #0x1234
+    constexpr std::array<u8, 6> Bytes = { 0x00, 0x7F, 0x12, 0x12, 0x12, 0x34 };
+
+    auto it = disasm::sweep<i8051>(Bytes, 1).begin();
+    if (!CHECK(it != std::default_sentinel))
+        return;
+
+    CHECK((*it).getOffset() == 1);
+    CHECK((*it).getBytes().size() == 2);
+    CHECK((*it).disassemble() == "mov R7, #0x0012");
+
+    ++it;
+    if (!CHECK(it != std::default_sentinel))
+        return;
+
+    CHECK((*it).getOffset() == 3);
+    CHECK((*it).disassemble() == "lcall #0x1234");
+
+    ++it;
+    CHECK(it == std::default_sentinel);
+}
+
+TEST_CASE("Instruction views disassemble like the decoded records") {
+    const auto bytes = test::generateRandomBytes(4 * 1024);
+    const auto instructions = disasm::decode<i8051>(bytes);
+
+    size_t index = 0, mismatches = 0;
+    for (const auto &view : disasm::sweep<i8051>(bytes)) {
+        if (index >= instructions.size())
+            break;
+
+        mismatches += view.disassemble() != disasm::disassembleInstruction<i8051>(instructions[index], bytes);
+        index++;
+    }
+
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,56 @@
+#include <decoders.hpp>
+
+#include <disasm/opcode_table.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    constexpr std::array<u8, 4> TrailingBytes = { 0x00, 0x5A, 0xA5, 0xFF };
+
+    /* Instructions of different sizes sharing leading bytes, so lookups have to go through the candidate lists */
+    template<hlp::StaticString PatternValue>
+    struct InstrTest : public disasm::Instruction<"test", PatternValue, disasm::Category::Other, std::endian::big> {
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
+
+        static ast::NodeList decompile(u64, std::span<const u8>) {
+            return { };
+        }
+    };
+
+    using SharedLeadingBytes = disasm::InstructionArray<
+            InstrTest<"1010'0000'1111'xxxx">,
+            InstrTest<"1010'0000'xxxx'xxxx'0101'1010">,
+            InstrTest<"1010'0000'xxxx'xxxx'xxxx'xxxx'xxxx'xxxx'1111'1111">,
+            InstrTest<"1010'xxxx">,
+            InstrTest<"0xxx'xx11'xxxx'xxx1">
+    >;
+
+}
+
+TEST_CASE("Thumb opcode table matches linear decoder") {
+    test::checkAgainstLinearDecoder<disasm::arm::v7::thumb::Architecture::Instructions, disasm::OpcodeTable>();
+}
+
+TEST_CASE("8051 opcode table matches linear decoder") {
+    test::checkAgainstLinearDecoder<disasm::i8051::Architecture::Instructions, disasm::OpcodeTable>(TrailingBytes);
+}
+
+TEST_CASE("Opcode table candidates share the leading byte") {
+    using Table = disasm::OpcodeTable<disasm::arm::v7::thumb::Architecture::Instructions>;
+
+    size_t candidateCount = 0;
+    for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+        CHECK(Table::getCandidateCount(u8(byte)) < disasm::arm::v7::thumb::Architecture::Instructions::Size);
+        candidateCount += Table::getCandidateCount(u8(byte));
+    }
+
+    CHECK(candidateCount > 0);
+    CHECK(!Table::hasCandidates(std::span<const u8>()));
+}
+
+TEST_CASE("Opcode table matches linear decoder for mixed size instructions") {
+    test::checkAgainstLinearDecoder<SharedLeadingBytes, disasm::OpcodeTable>(TrailingBytes);
+}
@@ -0,0 +1,75 @@
+#include <decoders.hpp>
+
+#include <disasm/parallel.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    // Large enough to be split into several chunks
+    constexpr size_t ImageSize = 1024 * 1024;
+
+}
+
+TEST_CASE("Parallel fixed width decoding matches the serial decode") {
+    hlp::ThreadPool pool(4);
+
+    for (u32 seed : { 1, 2, 3 }) {
+        const auto bytes = test::generateBytesWithDataRuns(ImageSize, seed);
+
+        test::checkSameRecords<Thumb>(disasm::decode<Thumb>(bytes), disasm::decode<Thumb>(bytes, pool));
+    }
+}
+
+TEST_CASE("Parallel fixed width decoding handles inputs smaller than a chunk") {
+    hlp::ThreadPool pool(4);
+
+    for (size_t size : { 0, 1, 2, 3, 101 }) {
+        const auto bytes = test::generateBytesWithDataRuns(size);
+
+        test::checkSameRecords<Thumb>(disasm::decode<Thumb>(bytes), disasm::decode<Thumb>(bytes, pool));
+    }
+}
+
+TEST_CASE("Parallel disassembly lines are in address order") {
+    hlp::ThreadPool pool(4);
+    const auto bytes = test::generateBytesWithDataRuns(ImageSize);
+
+    CHECK(disasm::disassemble<Thumb>(bytes, pool) == disasm::disassemble<Thumb>(bytes));
+}
+
+TEST_CASE("Parallel variable width decoding matches the serial decode") {
+    hlp::ThreadPool pool(4);
+
+    for (u32 seed : { 1, 2, 3 }) {
+        const auto bytes = test::generateBytesWithDataRuns(ImageSize, seed);
+
+        test::checkSameRecords<i8051>(disasm::decode<i8051>(bytes), disasm::decode<i8051>(bytes, pool));
+    }
+}
+
+TEST_CASE("Parallel variable width decoding resynchronizes chunks starting inside an instruction") {
+    hlp::ThreadPool pool(4);
+
+    // Nothing but three byte lcall instructions, so chunk boundaries keep falling into the middle of one
+    const std::vector<u8> bytes(ImageSize, 0x12);
+    const auto instructions = disasm::decode<i8051>(bytes, pool);
+
+    test::checkSameRecords<i8051>(disasm::decode<i8051>(bytes), instructions);
+    CHECK(instructions.size() == (ImageSize + 2) / 3);
+}
+
+TEST_CASE("Parallel variable width decoding handles inputs smaller than a chunk") {
+    hlp::ThreadPool pool(4);
+
+    for (size_t size : { 0, 1, 2, 3, 101 }) {
+        const auto bytes = test::generateBytesWithDataRuns(size);
+
+        test::checkSameRecords<i8051>(disasm::decode<i8051>(bytes), disasm::decode<i8051>(bytes, pool));
+    }
+}
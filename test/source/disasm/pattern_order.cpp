@@ -0,0 +1,125 @@
+#include <decoders.hpp>
+
+#include <disasm/pattern_order.hpp>
+#include <disasm/ARM/instructions.hpp>
+
+using namespace dc;
+
+namespace {
+
+    template<hlp::StaticString PatternValue>
+    struct InstrTest : public disasm::Instruction<"test", PatternValue, disasm::Category::Other, std::endian::big> {
+        static void disassemble(fmt::appender, u64, std::span<const u8>) { }
+
+        static ast::NodeList decompile(u64, std::span<const u8>) {
+            return { };
+        }
+    };
+
+    template<hlp::StaticString PatternValue>
+    struct InstrPreferred : public InstrTest<PatternValue> {
+        constexpr static auto Priority = 1;
+    };
+
+    /* Written from the most general to the most specific pattern, so the derived order has to reverse them */
+    using Nested = disasm::InstructionArray<
+            InstrTest<"1xxx'xxxx">,
+            InstrTest<"10xx'xxxx">,
+            InstrTest<"1010'xxxx">,
+            InstrTest<"1010'0101">,
+            InstrTest<"0000'xxxx">
+    >;
+
+    /* The two patterns overlap on 1100'0011 without either being more specific */
+    using Prioritized = disasm::InstructionArray<
+            InstrTest<"11xx'xxxx">,
+            InstrPreferred<"xxxx'xx11">
+    >;
+
+    using NestedOrder = disasm::PatternOrder<Nested>;
+
+}
+
+TEST_CASE("Overlaps are found between patterns sharing inputs") {
+    CHECK(NestedOrder::overlaps(0, 3));
+    CHECK(NestedOrder::overlaps(3, 0));
+    CHECK(NestedOrder::overlaps(1, 2));
+    CHECK(!NestedOrder::overlaps(0, 4));
+    CHECK(!NestedOrder::overlaps(3, 4));
+}
+
+TEST_CASE("More specific patterns have to precede the ones they overlap") {
+    CHECK(NestedOrder::mustPrecede(3, 0));
+    CHECK(NestedOrder::mustPrecede(2, 1));
+    CHECK(!NestedOrder::mustPrecede(0, 3));
+    CHECK(!NestedOrder::mustPrecede(4, 0));
+    CHECK(!NestedOrder::mustPrecede(0, 4));
+}
+
+TEST_CASE("Derived order puts specific patterns first") {
+    const auto &order = NestedOrder::getOrder();
+
+    CHECK(order[0] == 3);
+    CHECK(order[1] == 2);
+    CHECK(NestedOrder::isValidOrder(order));
+}
+
+TEST_CASE("Orders violating a precedence are rejected") {
+    constexpr std::array<size_t, 5> WrittenOrder  = { 0, 1, 2, 3, 4 };
+    constexpr std::array<size_t, 5> OtherValid    = { 4, 3, 2, 1, 0 };
+    constexpr std::array<size_t, 5> Duplicate     = { 3, 3, 2, 1, 0 };
+    constexpr std::array<size_t, 5> OutOfRange    = { 3, 2, 1, 0, 5 };
+    constexpr std::array<size_t, 4> Incomplete    = { 3, 2, 1, 0 };
+
+    CHECK(!NestedOrder::isValidOrder(WrittenOrder));
+    CHECK(NestedOrder::isValidOrder(OtherValid));
+    CHECK(!NestedOrder::isValidOrder(Duplicate));
+    CHECK(!NestedOrder::isValidOrder(OutOfRange));
+    CHECK(!NestedOrder::isValidOrder(Incomplete));
+
+    static_assert(NestedOrder::isValidOrder(OtherValid));
+}
+
+TEST_CASE("Linear decoding in specificity order finds the most specific match") {
+    using Ordered = disasm::OrderBySpecificity<Nested>;
+
+    size_t mismatches = 0;
+    for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+        const std::array<u8, 1> bytes = { u8(byte) };
+        const auto index = disasm::LinearDecoder<Ordered>::find(bytes);
+
+        size_t expected = Ordered::Size;
+        if (byte == 0b1010'0101)          expected = test::getInstructionIndex<Ordered, InstrTest<"1010'0101">>();
+        else if ((byte >> 4) == 0b1010)   expected = test::getInstructionIndex<Ordered, InstrTest<"1010'xxxx">>();
+        else if ((byte >> 6) == 0b10)     expected = test::getInstructionIndex<Ordered, InstrTest<"10xx'xxxx">>();
+        else if ((byte >> 7) == 0b1)      expected = test::getInstructionIndex<Ordered, InstrTest<"1xxx'xxxx">>();
+        else if ((byte >> 4) == 0b0000)   expected = test::getInstructionIndex<Ordered, InstrTest<"0000'xxxx">>();
+
+        mismatches += index != expected;
+    }
+
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Priority settles overlapping patterns of equal specificity") {
+    using Order = disasm::PatternOrder<Prioritized>;
+
+    CHECK(Order::overlaps(0, 1));
+    CHECK(Order::mustPrecede(1, 0));
+    CHECK(Order::getOrder()[0] == 1);
+}
+
+TEST_CASE("Thumb hint instructions aren't shadowed by IT") {
+    using namespace disasm::arm::v7::thumb;
+    using Instructions = Architecture::Instructions;
+
+    constexpr std::array<u8, 2> Nop = { 0x00, 0xBF }, Yield = { 0x10, 0xBF }, It = { 0x08, 0xBF };
+
+    constexpr auto NopIndex   = test::getInstructionIndex<Instructions, InstrNOP>();
+    constexpr auto YieldIndex = test::getInstructionIndex<Instructions, InstrYIELD>();
+    constexpr auto ItIndex    = test::getInstructionIndex<Instructions, InstrIT>();
+
+    CHECK(disasm::LinearDecoder<Instructions>::find(Nop) == NopIndex);
+    CHECK(disasm::LinearDecoder<Instructions>::find(Yield) == YieldIndex);
+    CHECK(disasm::LinearDecoder<Instructions>::find(It) == ItIndex);
+}
@@ -0,0 +1,108 @@
+#include <decoders.hpp>
+
+#include <disasm/profile.hpp>
+#include <disasm/profiled_decoder.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+#include <string>
+
+using namespace dc;
+
+namespace {
+
+    constexpr std::array<u8, 4> TrailingBytes = { 0x00, 0x5A, 0xA5, 0xFF };
+
+    using ThumbArchitecture = disasm::arm::v7::thumb::Architecture;
+    using I8051Architecture = disasm::i8051::Architecture;
+
+    /* Specificity order reversed wherever the overlap constraints allow it, standing in for a recorded order */
+    consteval auto getReversedOrder() {
+        using Order = disasm::PatternOrder<ThumbArchitecture::Instructions>;
+        constexpr auto Size = ThumbArchitecture::Instructions::Size;
+
+        std::array<size_t, Size> result = { };
+
+        std::array<bool, Size> placed = { };
+        for (size_t position = 0; position < Size; position++) {
+            for (size_t candidate = Size; candidate-- > 0;) {
+                if (placed[candidate])
+                    continue;
+
+                bool ready = true;
+                for (size_t other = 0; other < Size; other++)
+                    ready = ready && (placed[other] || !Order::mustPrecede(other, candidate));
+
+                if (ready) {
+                    placed[candidate] = true;
+                    result[position] = candidate;
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    constexpr auto ReversedOrder = getReversedOrder();
+
+    template<typename T>
+    using ReversedDecoder = disasm::ProfiledDecoder<T, ReversedOrder>;
+
+}
+
+TEST_CASE("Profiled decoder with the specificity order matches linear decoder") {
+    test::checkAgainstLinearDecoder<ThumbArchitecture::Instructions, disasm::ProfiledDecoder>();
+    test::checkAgainstLinearDecoder<I8051Architecture::Instructions, disasm::ProfiledDecoder>(TrailingBytes);
+}
+
+TEST_CASE("Profiled decoder with an explicit order matches linear decoder") {
+    CHECK(ReversedOrder != disasm::PatternOrder<ThumbArchitecture::Instructions>::getOrder());
+
+    test::checkAgainstLinearDecoder<ThumbArchitecture::Instructions, ReversedDecoder>();
+}
+
+TEST_CASE("Histogram order puts frequent instructions first") {
+    const auto bytes = test::generateRandomBytes(64 * 1024);
+
+    disasm::InstructionHistogram<I8051Architecture> histogram;
+    histogram.record(bytes);
+
+    const auto order = histogram.getMatchOrder();
+    const auto &specificityOrder = disasm::PatternOrder<I8051Architecture::Instructions>::getOrder();
+
+    CHECK(histogram.getTotalCount() > 0);
+    CHECK(disasm::PatternOrder<I8051Architecture::Instructions>::isValidOrder(order));
+    CHECK(histogram.getAverageMatchCount(order) <= histogram.getAverageMatchCount(specificityOrder));
+
+    // Unconstrained instructions are only ever placed behind more frequent ones
+    size_t inversions = 0;
+    for (size_t position = 1; position < order.size(); position++) {
+        const bool constrained = disasm::PatternOrder<I8051Architecture::Instructions>::mustPrecede(order[position], order[position - 1]);
+        inversions += !constrained && histogram.getCount(order[position]) > histogram.getCount(order[position - 1]);
+    }
+
+    CHECK(inversions == 0);
+}
+
+TEST_CASE("Empty histogram produces a valid order") {
+    disasm::InstructionHistogram<ThumbArchitecture> histogram;
+
+    CHECK(histogram.getTotalCount() == 0);
+    CHECK(histogram.getAverageMatchCount(histogram.getMatchOrder()) == 0);
+    CHECK(disasm::PatternOrder<ThumbArchitecture::Instructions>::isValidOrder(histogram.getMatchOrder()));
+}
+
+TEST_CASE("Order header declares the order and its decoder") {
+    disasm::InstructionHistogram<ThumbArchitecture> histogram;
+    histogram.record(test::generateRandomBytes(4096));
+
+    const auto header = disasm::generateOrderHeader(histogram, "dc::disasm::arm::v7::thumb::Architecture::Instructions", "disasm/ARM/instructions.hpp", "thumb");
+
+    CHECK(header.starts_with("#pragma once"));
+    CHECK(header.find("#include <disasm/ARM/instructions.hpp>") != std::string::npos);
+    CHECK(header.find("namespace dc::disasm::profiled::thumb {") != std::string::npos);
+    CHECK(header.find(fmt::format("inline constexpr std::array<size_t, {}> MatchOrder", ThumbArchitecture::Instructions::Size)) != std::string::npos);
+    CHECK(header.find("using Decoder = ProfiledDecoder<T, MatchOrder>;") != std::string::npos);
+    CHECK(header.find("template<>") == std::string::npos);
+}
@@ -0,0 +1,106 @@
+#include <decoders.hpp>
+
+#include <ast/flat_tree.hpp>
+#include <decomp/decompiler.hpp>
+#include <disasm/registers.hpp>
+#include <disasm/ARM/instructions.hpp>
+#include <disasm/i8051/instructions.hpp>
+
+#include <stdexcept>
+
+using namespace dc;
+
+namespace {
+
+    using i8051 = disasm::i8051::Architecture;
+    using Thumb = disasm::arm::v7::thumb::Architecture;
+
+    static_assert(disasm::RegisterName("R").appendDecimal(12).get() == "R12");
+    static_assert(disasm::RegisterName("R").appendDecimal(0).get() == "R0");
+    static_assert(disasm::RegisterName("0x").appendHex(0x3A, 2).get() == "0x3A");
+    static_assert(disasm::RegisterName().get().empty());
+
+    template<size_t Size>
+    bool hasEmptyNames(const disasm::RegisterTable<Size> &table) {
+        return std::ranges::any_of(table, [](const auto &name) { return name.get().empty(); });
+    }
+
+    /* Every register and flag id a lifter produces has to index the architecture's tables */
+    template<disasm::ArchitectureType T>
+    void checkLiftedIds(std::span<const u8> bytes, disasm::RegisterSet<T> &registers, disasm::FlagSet<T> &flags) {
+        const auto tree = ast::FlatTree::flatten(decomp::decompile<T>(bytes));
+
+        size_t outOfRange = 0;
+        for (auto id : tree.getRegisters()) {
+            if (id < registers.size()) registers.set(id);
+            else outOfRange++;
+        }
+
+        for (auto id : tree.getFlags()) {
+            if (id < flags.size()) flags.set(id);
+            else outOfRange++;
+        }
+
+        CHECK(outOfRange == 0);
+    }
+
+}
+
+TEST_CASE("Register names longer than their storage are rejected") {
+    bool thrown = false;
+    try {
+        disasm::RegisterName("A_REGISTER_NAME").append("_TOO_LONG");
+    } catch (const std::length_error &) {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+}
+
+TEST_CASE("8051 registers and flags are indexed by their address") {
+    CHECK(i8051::Registers[0x00].get() == "R0");
+    CHECK(i8051::Registers[0x07].get() == "R7");
+    CHECK(i8051::Registers[0x81].get() == "SP");
+    CHECK(i8051::Registers[0xE0].get() == "ACC");
+    CHECK(i8051::Registers[disasm::i8051::RegisterA].get() == "A");
+    CHECK(i8051::Registers[disasm::i8051::RegisterDPTR].get() == "DPTR");
+
+    CHECK(i8051::Flags[0x00].get() == "MEM.0");
+    CHECK(i8051::Flags[0x91].get() == "P1.1");
+    CHECK(i8051::Flags[0xD7].get() == "CY");
+    CHECK(i8051::Flags[disasm::i8051::FlagC].get() == "C");
+    CHECK(i8051::Flags[disasm::i8051::FlagPSWC].get() == "PSW.C");
+
+    CHECK(!hasEmptyNames(i8051::Registers));
+    CHECK(!hasEmptyNames(i8051::Flags));
+}
+
+TEST_CASE("Thumb registers and flags are indexed by their number") {
+    CHECK(Thumb::Registers[0].get() == "R0");
+    CHECK(Thumb::Registers[12].get() == "R12");
+    CHECK(Thumb::Registers[13].get() == "SP");
+    CHECK(Thumb::Registers[14].get() == "LR");
+    CHECK(Thumb::Registers[15].get() == "PC");
+
+    CHECK(Thumb::Flags[0].get() == "N");
+    CHECK(Thumb::Flags[3].get() == "V");
+
+    CHECK(!hasEmptyNames(Thumb::Registers));
+    CHECK(!hasEmptyNames(Thumb::Flags));
+}
+
+TEST_CASE("Lifted register and flag ids are within the architecture's tables") {
+    const auto bytes = test::generateRandomBytes(16 * 1024);
+
+    disasm::RegisterSet<i8051> registers;
+    disasm::FlagSet<i8051> flags;
+    checkLiftedIds<i8051>(bytes, registers, flags);
+
+    CHECK(registers.test(disasm::i8051::RegisterA));
+    CHECK(registers.test(0x00));
+    CHECK(flags.test(disasm::i8051::FlagC));
+
+    disasm::RegisterSet<Thumb> thumbRegisters;
+    disasm::FlagSet<Thumb> thumbFlags;
+    checkLiftedIds<Thumb>(bytes, thumbRegisters, thumbFlags);
+}
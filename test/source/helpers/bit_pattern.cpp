@@ -0,0 +1,97 @@
+#include <test.hpp>
+
+#include <helpers/bit_pattern.hpp>
+#include <helpers/utils.hpp>
+
+#include <array>
+#include <span>
+
+using namespace dc;
+
+namespace {
+
+    using BigEndianPattern    = hlp::BitPattern<"ppp0'0001'aaaa'aaaa", std::endian::big>;
+    using LittleEndianPattern = hlp::BitPattern<"010000'0101'mmm'nnn", std::endian::little>;
+    using WidePattern         = hlp::BitPattern<"1000'0101'ssss'ssss'dddd'dddd", std::endian::big>;
+
+    static_assert(BigEndianPattern::getBitMaskWord() == 0x1F00);
+    static_assert(BigEndianPattern::getBitCompareValueWord() == 0x0100);
+    static_assert(BigEndianPattern::getPlaceholderBitCount<'p'>() == 3);
+    static_assert(BigEndianPattern::getPlaceholderBitCount<'a'>() == 8);
+
+    static_assert(BigEndianPattern::matches(std::array<u8, 2> { 0xE1, 0x34 }));
+    static_assert(BigEndianPattern::getPlaceholderValue<'p'>(std::array<u8, 2> { 0xE1, 0x34 }) == 0b111);
+    static_assert(BigEndianPattern::getPlaceholderValue<'a'>(std::array<u8, 2> { 0xE1, 0x34 }) == 0x34);
+
+}
+
+TEST_CASE("Patterns load words in their byte order") {
+    const std::array<u8, 3> bytes = { 0x12, 0x34, 0x56 };
+
+    CHECK(BigEndianPattern::loadWord(bytes) == 0x1234);
+    CHECK(LittleEndianPattern::loadWord(bytes) == 0x3412);
+    CHECK(WidePattern::loadWord(bytes) == 0x123456);
+}
+
+TEST_CASE("Patterns only match inputs covering all of their bytes") {
+    const std::array<u8, 3> bytes = { 0x85, 0x12, 0x34 };
+
+    CHECK(WidePattern::matches(std::span(bytes)));
+    CHECK(!WidePattern::matches(std::span(bytes).first(2)));
+    CHECK(!WidePattern::matches(std::span<const u8>()));
+}
+
+TEST_CASE("Placeholder values are assembled from all of their bits") {
+    const std::array<u8, 2> bytes = { 0xA1, 0x7F };
+
+    CHECK(BigEndianPattern::matches(bytes));
+    CHECK(BigEndianPattern::getPlaceholderValue<'p'>(bytes) == 0b101);
+    CHECK(BigEndianPattern::getPlaceholderValue<'a'>(bytes) == 0x7F);
+
+    // adc R3, R5 is 0x416B, stored little endian
+    const std::array<u8, 2> thumbBytes = { 0x6B, 0x41 };
+
+    CHECK(LittleEndianPattern::matches(thumbBytes));
+    CHECK(LittleEndianPattern::getPlaceholderValue<'m'>(thumbBytes) == 5);
+    CHECK(LittleEndianPattern::getPlaceholderValue<'n'>(thumbBytes) == 3);
+}
+
+TEST_CASE("Patterns reject inputs differing in a fixed bit") {
+    size_t matchCount = 0;
+    for (u32 word = 0x0000; word <= 0xFFFF; word++) {
+        const std::array<u8, 2> bytes = { u8(word >> 8), u8(word) };
+        matchCount += BigEndianPattern::matches(bytes);
+    }
+
+    // 3 + 8 placeholder bits can take any value
+    CHECK(matchCount == (1 << 11));
+}
+
+TEST_CASE("Placeholders split over several segments are joined in pattern order") {
+    using AbsoluteJump = hlp::BitPattern<"aaa0'0001'aaaa'aaaa", std::endian::big>;
+    using Interleaved  = hlp::BitPattern<"a0a0'a0a0", std::endian::big>;
+
+    CHECK(AbsoluteJump::getPlaceholderValue<'a'>(std::array<u8, 2> { 0xE1, 0x34 }) == 0x734);
+    CHECK(AbsoluteJump::getPlaceholderValue<'a'>(std::array<u8, 2> { 0x21, 0xFF }) == 0x1FF);
+
+    size_t mismatches = 0;
+    for (u32 byte = 0x00; byte <= 0xFF; byte++) {
+        const std::array<u8, 1> bytes = { u8(byte) };
+        if (!Interleaved::matches(bytes))
+            continue;
+
+        const u32 expected = ((byte >> 4) & 0b1000) | ((byte >> 3) & 0b0100) | ((byte >> 2) & 0b0010) | ((byte >> 1) & 0b0001);
+        mismatches += Interleaved::getPlaceholderValue<'a'>(bytes) != expected;
+    }
+
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Byte swaps reverse the bytes of every width") {
+    CHECK(hlp::byteSwap(u8(0x12)) == 0x12);
+    CHECK(hlp::byteSwap(u16(0x1234)) == 0x3412);
+    CHECK(hlp::byteSwap(u32(0x12345678)) == 0x78563412);
+    CHECK(hlp::byteSwap(u64(0x0123456789ABCDEF)) == 0xEFCDAB8967452301);
+
+    static_assert(hlp::byteSwap(u32(0x000000FF)) == 0xFF000000);
+}
@@ -4,6 +4,8 @@
 #include <decomp/decompiler.hpp>
 #include <decomp/ll_decompiler.hpp>
 
+#include <ast/node_arena.hpp>
+
 int main() {
     constexpr std::array<uint8_t, 37627> data = {
             0x02, 0x44, 0x3C, 0xE4, 0xF5, 0xE4, 0xC2, 0x89, 0xC2, 0x8B, 0xF5, 0xC7, 0x75, 0xD7, 0x09, 0xF5,
@@ -2361,16 +2363,22 @@ int main() {
     };
 
     auto span = std::span<const dc::u8>(data.data(), 500);
+    auto instructions = dc::disasm::decode<dc::disasm::i8051::Architecture>(span);
+
+    dc::decomp::FileSink output(stdout);
 
-    fmt::print("Disassembly:\n");
-    for (const auto &line : dc::disasm::disassemble<dc::disasm::i8051::Architecture>(span)) {
-        printf("%s\n", line.c_str());
+    output.print("Disassembly:\n");
+    for (const auto &line : dc::disasm::disassemble<dc::disasm::i8051::Architecture>(span, instructions)) {
+        output.print("{}\n", line);
     }
 
-    fmt::print("\n\nDecompilation:\n");
-    dc::decomp::LowLevelDecompiler decompiler;
-    for (const auto &ast : dc::decomp::decompile<dc::disasm::i8051::Architecture>(span)) {
+    output.print("\n\nDecompilation:\n");
+    dc::ast::NodeArena arena;
+    dc::ast::NodeArenaScope arenaScope(arena);
+
+    dc::decomp::LowLevelDecompiler decompiler(output, dc::disasm::i8051::Architecture::Registers, dc::disasm::i8051::Architecture::Flags);
+    for (const auto &ast : dc::decomp::decompile<dc::disasm::i8051::Architecture>(span, instructions)) {
         ast->accept(decompiler);
-        fmt::print(";\n");
+        output.print(";\n");
     }
 }
\ No newline at end of file
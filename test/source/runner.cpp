@@ -0,0 +1,13 @@
+#include <test.hpp>
+
+int main() {
+    for (const auto &testCase : dc::test::getTestCases()) {
+        const auto failureCount = dc::test::getFailureCount();
+
+        testCase.function();
+
+        fmt::print("{} {}\n", dc::test::getFailureCount() == failureCount ? "[PASS]" : "[FAIL]", testCase.name);
+    }
+
+    return dc::test::getFailureCount() == 0 ? 0 : 1;
+}